@@ -11,10 +11,17 @@ struct Axis
 
 namespace axis
 {
-	[[nodiscard]] inline VECTOR GetWorldXAxis() { return VGet(1.0f, 0.0f, 0.0f); }
-	[[nodiscard]] inline VECTOR GetWorldYAxis() { return VGet(0.0f, 1.0f, 0.0f); }
-	[[nodiscard]] inline VECTOR GetWorldZAxis() { return VGet(0.0f, 0.0f, 1.0f); }
-	[[nodiscard]] inline Axis   GetWorldAxis () { return Axis(GetWorldXAxis(), GetWorldYAxis(), GetWorldZAxis()); }
+	[[nodiscard]] constexpr VECTOR GetWorldXAxis() { return { 1.0f, 0.0f, 0.0f }; }
+	[[nodiscard]] constexpr VECTOR GetWorldYAxis() { return { 0.0f, 1.0f, 0.0f }; }
+	[[nodiscard]] constexpr VECTOR GetWorldZAxis() { return { 0.0f, 0.0f, 1.0f }; }
+	[[nodiscard]] constexpr Axis   GetWorldAxis () { return Axis(GetWorldXAxis(), GetWorldYAxis(), GetWorldZAxis()); }
+
+	/// @brief ]s̊es玲𐶐 (RpCɂvZł)
+	/// @brief s̉]Kł邱ƂOƂAK͍sȂ
+	[[nodiscard]] constexpr Axis CreateFromRotMatrix(const MATRIX& rot)
+	{
+		return Axis({ rot.m[0][0], rot.m[0][1], rot.m[0][2] }, { rot.m[1][0], rot.m[1][1], rot.m[1][2] }, { rot.m[2][0], rot.m[2][1], rot.m[2][2] });
+	}
 
 	inline void Draw(const Axis& axis, const VECTOR& begin_pos, const float length)
 	{
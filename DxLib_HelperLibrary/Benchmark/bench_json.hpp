@@ -0,0 +1,222 @@
+﻿#pragma once
+#include <filesystem>
+#include <Benchmark/bench_vector.hpp>
+#include <JSON/json_loader.hpp>
+#include <JSON/json_async_loader.hpp>
+#include <JSON/json_cache.hpp>
+#include <JSON/json_sax_reader.hpp>
+
+namespace benchmark
+{
+	/// @brief 計測用の一時ファイルパスを取得する
+	[[nodiscard]] inline std::string GetTempFilePath(const std::string& file_name)
+	{
+		return (std::filesystem::temp_directory_path() / ("dxlib_helper_benchmark_" + file_name)).string();
+	}
+
+	/// @brief 座標リストを持つJSONデータを生成する
+	/// @param is_compact 座標を配列([x, y, z])で表現するかどうか
+	[[nodiscard]] inline nlohmann::json CreatePointsJson(const size_t num, const bool is_compact = false)
+	{
+		const auto points = CreateRandomVectors(num, 41);
+		const json_loader::ScopedCompactEncoding encoding(is_compact);
+
+		nlohmann::json j_data;
+		j_data["points"] = points;
+		return j_data;
+	}
+
+	/// @brief 計測するバイナリ形式の名前と拡張子
+	inline const std::pair<std::string, std::string> kBinaryFormats[] =
+	{
+		{ "msgpack", ".msgpack" },
+		{ "cbor",	 ".cbor"	},
+		{ "bson",	 ".bson"	},
+		{ "ubjson",	 ".ubjson"	},
+	};
+
+	inline void RegisterJsonBenchmarks(Suite& suite)
+	{
+		for (const size_t num : { size_t(1000), size_t(100000) })
+		{
+			const auto data		 = std::make_shared<nlohmann::json>(CreatePointsJson(num));
+			const auto file_path = GetTempFilePath("points_" + std::to_string(num) + ".json");
+			const auto suffix	 = "/points_" + std::to_string(num);
+
+			// 読み込み用のファイルを用意する
+			if (!json_loader::Save(file_path, *data)) { continue; }
+
+			const auto file_size = std::filesystem::file_size(file_path);
+			const auto counters  = [file_size] { return nlohmann::json{ { "file_bytes", file_size } }; };
+
+			suite.Add("json_loader/Save" + suffix, num, [=]
+			{
+				DoNotOptimize(json_loader::Save(file_path, *data));
+			}, counters);
+
+			suite.Add("json_loader/Load" + suffix, num, [=]
+			{
+				nlohmann::json j_data;
+				DoNotOptimize(json_loader::Load(file_path, j_data));
+				DoNotOptimize(j_data);
+			}, counters);
+
+			suite.Add("json_loader/LoadMapped" + suffix, num, [=]
+			{
+				nlohmann::json j_data;
+				DoNotOptimize(json_loader::LoadMapped(file_path, j_data));
+				DoNotOptimize(j_data);
+			}, counters);
+
+			// 型への読み込み (DOMを経由するfrom_jsonとSAXの比較)
+			suite.Add("json_loader/LoadMapped+from_json" + suffix, num, [=]
+			{
+				nlohmann::json j_data;
+				if (!json_loader::LoadMapped(file_path, j_data)) { return; }
+
+				const auto points = j_data.at("points").get<std::vector<VECTOR>>();
+				DoNotOptimize(points.data());
+			}, counters);
+
+			suite.Add("json_loader/LoadTypedArray" + suffix, num, [=]
+			{
+				std::vector<VECTOR> points;
+				DoNotOptimize(json_loader::LoadTypedArray(file_path, points, "points"));
+				DoNotOptimize(points.data());
+			}, counters);
+
+			// 2回目以降はキャッシュから返される
+			const auto cache = std::make_shared<json_loader::DocumentCache>();
+			suite.Add("json_loader/DocumentCache/Get" + suffix, num, [=]
+			{
+				DoNotOptimize(cache->Get(file_path));
+			}, [cache] { const auto stats = cache->GetStats(); return nlohmann::json{ { "hit_num", stats.hit_num }, { "miss_num", stats.miss_num } }; });
+
+			// バイナリ形式
+			for (const auto& [format_name, extension] : kBinaryFormats)
+			{
+				const auto binary_path = GetTempFilePath("points_" + std::to_string(num) + extension);
+				if (!json_loader::Save(binary_path, *data)) { continue; }
+
+				const auto binary_size	   = std::filesystem::file_size(binary_path);
+				const auto binary_counters = [binary_size] { return nlohmann::json{ { "file_bytes", binary_size } }; };
+
+				suite.Add("json_loader/Save/" + format_name + suffix, num, [=]
+				{
+					DoNotOptimize(json_loader::Save(binary_path, *data));
+				}, binary_counters);
+
+				suite.Add("json_loader/Load/" + format_name + suffix, num, [=]
+				{
+					nlohmann::json j_data;
+					DoNotOptimize(json_loader::Load(binary_path, j_data));
+					DoNotOptimize(j_data);
+				}, binary_counters);
+			}
+		}
+
+		// 座標の表現の比較 (オブジェクトと配列)
+		for (const size_t num : { size_t(1000), size_t(100000) })
+		{
+			const auto file_path = GetTempFilePath("points_compact_" + std::to_string(num) + ".json");
+			const auto suffix	 = "/points_" + std::to_string(num);
+			if (!json_loader::Save(file_path, CreatePointsJson(num, true))) { continue; }
+
+			const auto file_size = std::filesystem::file_size(file_path);
+			const auto counters  = [file_size] { return nlohmann::json{ { "file_bytes", file_size } }; };
+
+			suite.Add("json_loader/LoadMapped+from_json/compact" + suffix, num, [=]
+			{
+				nlohmann::json j_data;
+				if (!json_loader::LoadMapped(file_path, j_data)) { return; }
+
+				const auto points = j_data.at("points").get<std::vector<VECTOR>>();
+				DoNotOptimize(points.data());
+			}, counters);
+
+			suite.Add("json_loader/LoadTypedArray/compact" + suffix, num, [=]
+			{
+				std::vector<VECTOR> points;
+				DoNotOptimize(json_loader::LoadTypedArray(file_path, points, "points"));
+				DoNotOptimize(points.data());
+			}, counters);
+		}
+
+		// 複数ファイルの読み込み (逐次読み込みと非同期ローダーの比較)
+		{
+			constexpr size_t file_num = 16;
+			constexpr size_t num	  = 10000;
+			const auto data = CreatePointsJson(num);
+
+			auto file_paths = std::make_shared<std::vector<std::string>>();
+			for (size_t i = 0; i < file_num; ++i)
+			{
+				file_paths->emplace_back(GetTempFilePath("points_multi_" + std::to_string(i) + ".json"));
+				if (!json_loader::Save(file_paths->back(), data)) { return; }
+			}
+
+			const auto suffix = "/points_" + std::to_string(num) + "x" + std::to_string(file_num);
+
+			suite.Add("json_loader/Load" + suffix, num * file_num, [=]
+			{
+				for (const auto& file_path : *file_paths)
+				{
+					nlohmann::json j_data;
+					DoNotOptimize(json_loader::Load(file_path, j_data));
+					DoNotOptimize(j_data);
+				}
+			});
+
+			const auto loader = std::make_shared<json_loader::AsyncLoader>();
+			suite.Add("json_loader/AsyncLoader" + suffix, num * file_num, [=]
+			{
+				std::vector<std::future<json_loader::LoadResult>> futures;
+				for (const auto& file_path : *file_paths) { futures.emplace_back(loader->RequestFuture(file_path)); }
+				for (auto& future : futures)			  { DoNotOptimize(future.get().status); }
+			}, [loader] { return nlohmann::json{ { "threads", loader->GetThreadNum() } }; });
+		}
+
+		// 大きなドキュメントの保存 (文字列経由の従来方式とストリーム直接書き込みの比較)
+		{
+			constexpr size_t num = 300000;
+			const auto data		 = std::make_shared<nlohmann::json>(CreatePointsJson(num));
+			const auto file_path = GetTempFilePath("points_large.json");
+			const auto suffix	 = "/points_" + std::to_string(num);
+
+			const auto add_case = [&](const std::string& name, std::function<void()> func)
+			{
+				const auto counters = [file_path, func]
+				{
+					return nlohmann::json
+					{
+						{ "file_bytes",			  std::filesystem::file_size(file_path) },
+						{ "peak_rss_growth_kb", MeasurePeakMemoryGrowthKb(func) }
+					};
+				};
+				suite.Add(name + suffix, num, func, counters);
+			};
+
+			add_case("json_loader/SaveDumpString", [=]
+			{
+				std::ofstream ofs(file_path, std::ios::out);
+				ofs << data->dump(4);
+				DoNotOptimize(ofs.good());
+			});
+
+			add_case("json_loader/Save", [=]
+			{
+				DoNotOptimize(json_loader::Save(file_path, *data));
+			});
+
+			add_case("json_loader/Save/compact", [=]
+			{
+				DoNotOptimize(json_loader::Save(file_path, *data, json_loader::Format::kText, json_loader::kIndentCompact));
+			});
+
+			add_case("json_loader/SaveAtomic", [=]
+			{
+				DoNotOptimize(json_loader::SaveAtomic(file_path, *data));
+			});
+		}
+	}
+}
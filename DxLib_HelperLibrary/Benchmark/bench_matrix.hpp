@@ -0,0 +1,195 @@
+﻿#pragma once
+#include <memory>
+#include <random>
+#include <Benchmark/benchmark.hpp>
+#include <Matrix/matrix.hpp>
+#include <Matrix/affine_matrix.hpp>
+#include <Quaternion/quaternion.hpp>
+
+namespace benchmark
+{
+	/// @brief 計測用の乱数TRS行列を生成する (シード固定)
+	[[nodiscard]] inline std::vector<MATRIX> CreateRandomMatrices(const size_t num, const unsigned int seed)
+	{
+		std::mt19937 engine(seed);
+		std::uniform_real_distribution<float> angle_dist(-3.14159f, 3.14159f);
+		std::uniform_real_distribution<float> scale_dist(0.5f, 2.0f);
+		std::uniform_real_distribution<float> pos_dist(-100.0f, 100.0f);
+
+		std::vector<MATRIX> matrices(num);
+		for (auto& mat : matrices)
+		{
+			const auto x = angle_dist(engine);
+			const auto y = angle_dist(engine);
+			const auto rot = matrix::CreateXMatrix(std::cos(x), std::sin(x)) * matrix::CreateYMatrix(std::cos(y), std::sin(y));
+			mat = matrix::Compose(VGet(pos_dist(engine), pos_dist(engine), pos_dist(engine)), VGet(scale_dist(engine), scale_dist(engine), scale_dist(engine)), rot);
+		}
+		return matrices;
+	}
+
+	inline void RegisterMatrixBenchmarks(Suite& suite)
+	{
+		constexpr size_t num = 1024;
+
+		const auto m1 = std::make_shared<std::vector<MATRIX>>(CreateRandomMatrices(num, 11));
+		const auto m2 = std::make_shared<std::vector<MATRIX>>(CreateRandomMatrices(num, 12));
+		const auto mo = std::make_shared<std::vector<MATRIX>>(num);
+		const auto vo = std::make_shared<std::vector<VECTOR>>(num);
+
+		// 積 (DxLibのMMultと、インライン展開されるmatrix::Multiply)
+		// MEMO : ヘッドレス環境のMMultはインライン実装のため、実機のMMultより速く計測される
+		suite.Add("matrix/MMult/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*mo)[i] = MMult((*m1)[i], (*m2)[i]); }
+			DoNotOptimize(*mo->data());
+		});
+
+		suite.Add("matrix/operator*/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*mo)[i] = (*m1)[i] * (*m2)[i]; }
+			DoNotOptimize(*mo->data());
+		});
+
+		suite.Add("matrix/MultiplyArray/1024", num, [=]
+		{
+			matrix::MultiplyArray(m1->data(), m2->data(), mo->data(), num);
+			DoNotOptimize(*mo->data());
+		});
+
+		suite.Add("matrix/MultiplyArray(shared rhs)/1024", num, [=]
+		{
+			matrix::MultiplyArray(m1->data(), (*m2)[0], mo->data(), num);
+			DoNotOptimize(*mo->data());
+		});
+
+		// 100体 × 65ボーンの階層連結
+		constexpr size_t bone_num	   = 65;
+		constexpr size_t character_num = 100;
+
+		const auto locals  = std::make_shared<std::vector<MATRIX>>(CreateRandomMatrices(bone_num * character_num, 13));
+		const auto worlds  = std::make_shared<std::vector<MATRIX>>(bone_num * character_num);
+		const auto parents = std::make_shared<std::vector<int>>(bone_num);
+		for (size_t i = 0; i < bone_num; ++i) { (*parents)[i] = static_cast<int>(i) - 1 - static_cast<int>(i % 4 == 0 ? i / 2 : 0); }
+
+		suite.Add("matrix/ConcatenateHierarchy/operator*/100x65", bone_num * character_num, [=]
+		{
+			for (size_t c = 0; c < character_num; ++c)
+			{
+				const auto local = locals->data() + c * bone_num;
+				const auto world = worlds->data() + c * bone_num;
+				for (size_t i = 0; i < bone_num; ++i)
+				{
+					const auto parent = (*parents)[i];
+					world[i] = parent < 0 ? local[i] : MMult(local[i], world[parent]);
+				}
+			}
+			DoNotOptimize(*worlds->data());
+		});
+
+		suite.Add("matrix/ConcatenateHierarchy/batched/100x65", bone_num * character_num, [=]
+		{
+			for (size_t c = 0; c < character_num; ++c)
+			{
+				matrix::ConcatenateHierarchy(locals->data() + c * bone_num, parents->data(), worlds->data() + c * bone_num, bone_num);
+			}
+			DoNotOptimize(*worlds->data());
+		});
+
+		// AffineMatrix
+		const auto a1 = std::make_shared<std::vector<AffineMatrix>>(num);
+		const auto a2 = std::make_shared<std::vector<AffineMatrix>>(num);
+		const auto ao = std::make_shared<std::vector<AffineMatrix>>(num);
+		for (size_t i = 0; i < num; ++i) { (*a1)[i] = matrix::ToAffine((*m1)[i]); (*a2)[i] = matrix::ToAffine((*m2)[i]); }
+
+		suite.Add("affine_matrix/operator*/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*ao)[i] = (*a1)[i] * (*a2)[i]; }
+			DoNotOptimize(*ao->data());
+		});
+
+		suite.Add("affine_matrix/Inverse/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*ao)[i] = matrix::Inverse((*a1)[i]); }
+			DoNotOptimize(*ao->data());
+		});
+
+		// 成分の取得・設定
+		suite.Add("matrix/GetScale/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*vo)[i] = matrix::GetScale((*m1)[i]); }
+			DoNotOptimize(*vo->data());
+		});
+
+		suite.Add("matrix/GetRotMatrix/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*mo)[i] = matrix::GetRotMatrix((*m1)[i]); }
+			DoNotOptimize(*mo->data());
+		});
+
+		suite.Add("matrix/SetScale/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*mo)[i] = (*m1)[i]; matrix::SetScale((*mo)[i], VGet(1.0f, 2.0f, 3.0f)); }
+			DoNotOptimize(*mo->data());
+		});
+
+		suite.Add("matrix/SetRot/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*mo)[i] = (*m1)[i]; matrix::SetRot((*mo)[i], (*m2)[0]); }
+			DoNotOptimize(*mo->data());
+		});
+
+		// 分解 (個別の取得関数と、一度で分解するDecomposeの比較)
+		suite.Add("matrix/Decompose/separate/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i)
+			{
+				const auto pos	 = matrix::GetPos((*m1)[i]);
+				const auto scale = matrix::GetScale((*m1)[i]);
+				const auto rot	 = matrix::GetRotMatrix((*m1)[i]);
+				DoNotOptimize(pos);
+				DoNotOptimize(scale);
+				DoNotOptimize(rot);
+			}
+		});
+
+		suite.Add("matrix/Decompose/single_pass/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i)
+			{
+				const auto decomposed = matrix::Decompose((*m1)[i]);
+				DoNotOptimize(decomposed);
+			}
+		});
+
+		suite.Add("matrix/DecomposeQ/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i)
+			{
+				const auto decomposed = matrix::DecomposeQ((*m1)[i]);
+				DoNotOptimize(decomposed);
+			}
+		});
+
+		// クォータニオン補間
+		const auto q1 = std::make_shared<std::vector<Quaternion>>(num);
+		const auto q2 = std::make_shared<std::vector<Quaternion>>(num);
+		const auto qo = std::make_shared<std::vector<Quaternion>>(num);
+		for (size_t i = 0; i < num; ++i)
+		{
+			(*q1)[i] = quaternion::CreateFromRotMatrix(matrix::Decompose((*m1)[i]).rot);
+			(*q2)[i] = quaternion::CreateFromRotMatrix(matrix::Decompose((*m2)[i]).rot);
+		}
+
+		suite.Add("quaternion/NlerpArray/1024", num, [=]
+		{
+			quaternion::NlerpArray(q1->data(), q2->data(), 0.3f, qo->data(), num);
+			DoNotOptimize(*qo->data());
+		});
+
+		suite.Add("quaternion/SlerpArray/1024", num, [=]
+		{
+			quaternion::SlerpArray(q1->data(), q2->data(), 0.3f, qo->data(), num);
+			DoNotOptimize(*qo->data());
+		});
+	}
+}
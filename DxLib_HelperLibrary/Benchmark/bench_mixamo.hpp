@@ -0,0 +1,94 @@
+﻿#pragma once
+#include <Benchmark/bench_matrix.hpp>
+#include <MixamoHelper/mixamo_helper.hpp>
+
+namespace benchmark
+{
+	/// @brief スケルトンと同じフレーム構成の仮想モデルを生成する (ヘッドレス環境のみ)
+	/// @return モデルハンドル (生成できない場合は-1)
+	[[nodiscard]] inline int CreateMixamoModel(const mixamo_helper::Skeleton& skeleton)
+	{
+#if defined(DXLIB_HELPER_HEADLESS)
+		const auto model_handle = DxLib::headless::CreateModel(skeleton.frame_names, skeleton.parent_indices);
+		const auto matrices		= CreateRandomMatrices(skeleton.frame_names.size(), 21);
+		for (size_t i = 0; i < matrices.size(); ++i)
+		{
+			DxLib::headless::SetFrameLocalWorldMatrix(model_handle, static_cast<int>(i), matrices[i]);
+		}
+		return model_handle;
+#else
+		static_cast<void>(skeleton);
+		return -1;
+#endif
+	}
+
+	/// @brief 1回分の描画呼び出し数をカウンタとして取得する
+	/// @param draw_func 描画処理
+	template<typename FuncT>
+	[[nodiscard]] inline nlohmann::json GetDrawCounters(FuncT&& draw_func)
+	{
+#if defined(DXLIB_HELPER_HEADLESS)
+		DxLib::headless::ResetDrawRecord();
+		draw_func();
+
+		const auto& record = DxLib::headless::GetDrawRecord();
+		return
+		{
+			{ "lines",		record.line_count },
+			{ "spheres",	record.sphere_count },
+			{ "cones",		record.cone_count }
+		};
+#else
+		static_cast<void>(draw_func);
+		return nullptr;
+#endif
+	}
+
+	inline void RegisterMixamoBenchmarks(Suite& suite)
+	{
+		constexpr size_t num = 1024;
+
+		const auto matrices = std::make_shared<std::vector<MATRIX>>(CreateRandomMatrices(num, 31));
+		const auto axes		= std::make_shared<std::vector<Axis>>(num);
+
+		suite.Add("mixamo_helper/ConvertRotMatrixToAxis/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*axes)[i] = mixamo_helper::ConvertRotMatrixToAxis((*matrices)[i]); }
+			DoNotOptimize(*axes->data());
+		});
+
+		// 変更前のDrawFramesが毎回行っていた階層ファイルの読み込み
+		suite.Add("mixamo_helper/LoadHierarchyJson", 1, []
+		{
+			nlohmann::json j_data;
+			DoNotOptimize(json_loader::Load(mixamo_helper::kFrameHierarchyFilePath, j_data));
+			DoNotOptimize(j_data);
+		});
+
+		const auto& skeleton	 = mixamo_helper::GetSkeleton();
+		const auto	model_handle = CreateMixamoModel(skeleton);
+		if (skeleton.frame_names.empty() || model_handle == -1)
+		{
+			std::fprintf(stderr, "mixamo_helper : skipped DrawFrames (hierarchy file or headless model unavailable)\n");
+			return;
+		}
+
+		const auto bone_num = skeleton.frame_names.size();
+		const auto pose		= std::make_shared<mixamo_helper::Pose>();
+
+		// 姿勢からの描画を単独で計測できるよう、あらかじめ取得しておく
+		mixamo_helper::CapturePose(model_handle, skeleton, *pose);
+
+		suite.Add("mixamo_helper/CapturePose", bone_num, [=, &skeleton]
+		{
+			mixamo_helper::CapturePose(model_handle, skeleton, *pose);
+			DoNotOptimize(pose->bones.data());
+		});
+
+		const auto draw_pose  = [=, &skeleton] { mixamo_helper::DrawFrames(skeleton, *pose); };
+		const auto draw_model = [=] { mixamo_helper::DrawFrames(model_handle); };
+
+		suite.Add("mixamo_helper/DrawFrames(pose)", bone_num, draw_pose,	[=] { return GetDrawCounters(draw_pose); });
+		suite.Add("mixamo_helper/DrawFrames",		bone_num, draw_model,	[=] { return GetDrawCounters(draw_model); });
+	}
+}
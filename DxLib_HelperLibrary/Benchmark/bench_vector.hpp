@@ -0,0 +1,650 @@
+﻿#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <Benchmark/benchmark.hpp>
+#include <Vector/vector_2d.hpp>
+#include <Vector/vector_2d_expression.hpp>
+#include <Vector/vector_array_2d.hpp>
+#include <Vector/vector_3d.hpp>
+#include <Vector/vector_array_3d.hpp>
+
+namespace benchmark
+{
+	/// @brief 計測用の乱数ベクトル配列を生成する (シード固定)
+	[[nodiscard]] inline std::vector<VECTOR> CreateRandomVectors(const size_t num, const unsigned int seed)
+	{
+		std::mt19937 engine(seed);
+		std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+		std::vector<VECTOR> vectors(num);
+		for (auto& v : vectors) { v = VGet(dist(engine), dist(engine), dist(engine)); }
+		return vectors;
+	}
+
+	[[nodiscard]] inline std::vector<Vector2D<float>> CreateRandomVector2Ds(const size_t num, const unsigned int seed)
+	{
+		std::mt19937 engine(seed);
+		std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+		std::vector<Vector2D<float>> vectors(num);
+		for (auto& v : vectors) { v = Vector2D<float>{ dist(engine), dist(engine) }; }
+		return vectors;
+	}
+
+	/// @brief 正規化結果の誤差を倍精度で求めた値と比較する
+	/// @param get_in 入力のi番目の成分 (x, y, z)
+	/// @param get_out 出力のi番目の成分 (x, y, z)
+	[[nodiscard]] inline nlohmann::json GetNormalizeError(const size_t num, const std::function<VECTOR(size_t)>& get_in, const std::function<VECTOR(size_t)>& get_out)
+	{
+		double max_error		= 0.0;
+		double max_size_error	= 0.0;
+		for (size_t i = 0; i < num; ++i)
+		{
+			const auto in  = get_in(i);
+			const auto out = get_out(i);
+
+			const auto size = std::sqrt(double(in.x) * in.x + double(in.y) * in.y + double(in.z) * in.z);
+			if (size == 0.0) { continue; }
+
+			max_error = std::max({ max_error, std::abs(out.x - in.x / size), std::abs(out.y - in.y / size), std::abs(out.z - in.z / size) });
+			max_size_error = std::max(max_size_error, std::abs(std::sqrt(double(out.x) * out.x + double(out.y) * out.y + double(out.z) * out.z) - 1.0));
+		}
+
+		return { { "max_error", max_error }, { "max_size_error", max_size_error } };
+	}
+
+	/// @brief 固定小数点数の一括演算の出力を、要素ごとにスカラー版(Vector2D<Fixed>の関数)で求めた結果と比較する
+	/// @brief raw_hashは出力の内部表現のFNV-1aハッシュで、ビルド設定やSIMDの有無が異なる実行結果と比較できる
+	/// @param get_out 出力のi番目の値 (Fixed または Vector2D<Fixed>)
+	/// @param get_reference スカラー版で求めたi番目の値
+	template<typename ValueT>
+	[[nodiscard]] inline nlohmann::json GetFixedCheck(const size_t num, const std::function<ValueT(size_t)>& get_out, const std::function<ValueT(size_t)>& get_reference)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		const auto hash_raw = [&](const Fixed f)
+		{
+			const auto raw = static_cast<uint32_t>(f.raw);
+			for (int shift = 0; shift < 32; shift += 8) { hash = (hash ^ ((raw >> shift) & 0xff)) * 1099511628211ull; }
+		};
+
+		size_t mismatch_num = 0;
+		for (size_t i = 0; i < num; ++i)
+		{
+			const auto out = get_out(i);
+			mismatch_num += out != get_reference(i) ? 1 : 0;
+
+			if constexpr (std::same_as<ValueT, Fixed>)	{ hash_raw(out); }
+			else										{ hash_raw(out.x); hash_raw(out.y); }
+		}
+
+		char hash_text[19];
+		std::snprintf(hash_text, sizeof(hash_text), "0x%016llx", static_cast<unsigned long long>(hash));
+		return { { "mismatch_num", mismatch_num }, { "raw_hash", hash_text } };
+	}
+
+	/// @brief Vector2D配列の a + b * s - c を3通りで計測する
+	/// @brief temporary : 演算ごとに配列全体を処理し一時配列を作る, operator : 要素ごとに演算子で求める, expression : 式テンプレートで1パスで求める
+	template<typename ElemT>
+	inline void RegisterVector2DExpressionBenchmarks(Suite& suite, const std::string& type_name)
+	{
+		constexpr size_t num   = 100000;
+		constexpr float  scale = 0.5f;
+
+		const auto to_elem = [](const std::vector<Vector2D<float>>& v)
+		{
+			std::vector<Vector2D<ElemT>> result(v.size());
+			for (size_t i = 0; i < v.size(); ++i) { result[i] = v[i]; }
+			return result;
+		};
+
+		const auto a   = std::make_shared<std::vector<Vector2D<ElemT>>>(to_elem(CreateRandomVector2Ds(num, 6)));
+		const auto b   = std::make_shared<std::vector<Vector2D<ElemT>>>(to_elem(CreateRandomVector2Ds(num, 7)));
+		const auto c   = std::make_shared<std::vector<Vector2D<ElemT>>>(to_elem(CreateRandomVector2Ds(num, 8)));
+		const auto out = std::make_shared<std::vector<Vector2D<ElemT>>>(num);
+
+		// 要素ごとに演算子で求めた結果との不一致数
+		const auto mismatch = [=]
+		{
+			size_t mismatch_num = 0;
+			for (size_t i = 0; i < num; ++i) { mismatch_num += (*out)[i] != (*a)[i] + (*b)[i] * scale - (*c)[i] ? 1 : 0; }
+			return nlohmann::json{ { "mismatch_num", mismatch_num } };
+		};
+
+		const auto prefix = "vector_2d_expression/" + type_name;
+
+		suite.Add(prefix + "/temporary/100000", num, [=]
+		{
+			std::vector<Vector2D<ElemT>> scaled(num);
+			std::vector<Vector2D<ElemT>> added(num);
+			for (size_t i = 0; i < num; ++i) { scaled[i] = (*b)[i] * scale; }
+			for (size_t i = 0; i < num; ++i) { added[i]  = (*a)[i] + scaled[i]; }
+			for (size_t i = 0; i < num; ++i) { (*out)[i] = added[i] - (*c)[i]; }
+			DoNotOptimize(*out->data());
+		}, mismatch);
+
+		suite.Add(prefix + "/operator/100000", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*out)[i] = (*a)[i] + (*b)[i] * scale - (*c)[i]; }
+			DoNotOptimize(*out->data());
+		}, mismatch);
+
+		suite.Add(prefix + "/expression/100000", num, [=]
+		{
+			using v2d::expr::Ref;
+			v2d::expr::Evaluate(Ref(*a) + Ref(*b) * scale - Ref(*c), *out);
+			DoNotOptimize(*out->data());
+		}, mismatch);
+
+		// 演算子ごとの式 (結果は要素ごとの演算子と比較する)
+		const Vector2D<ElemT> v = { ElemT(3), ElemT(-2) };
+
+		const auto add_operator = [&](const std::string& name, auto evaluate, auto reference)
+		{
+			suite.Add(prefix + "/expression/" + name + "/100000", num, [=]
+			{
+				evaluate();
+				DoNotOptimize(*out->data());
+			}, [=]
+			{
+				size_t mismatch_num = 0;
+				for (size_t i = 0; i < num; ++i) { mismatch_num += (*out)[i] != reference(i) ? 1 : 0; }
+				return nlohmann::json{ { "mismatch_num", mismatch_num } };
+			});
+		};
+
+		using v2d::expr::Ref;
+		using v2d::expr::Evaluate;
+		add_operator("expr+expr",	[=] { Evaluate(Ref(*a) + Ref(*b), *out); },	[=](const size_t i) { return (*a)[i] + (*b)[i]; });
+		add_operator("expr+vector", [=] { Evaluate(Ref(*a) + v, *out); },		[=](const size_t i) { return (*a)[i] + v; });
+		add_operator("vector+expr", [=] { Evaluate(v + Ref(*a), *out); },		[=](const size_t i) { return v + (*a)[i]; });
+		add_operator("expr-expr",	[=] { Evaluate(Ref(*a) - Ref(*b), *out); },	[=](const size_t i) { return (*a)[i] - (*b)[i]; });
+		add_operator("expr-vector", [=] { Evaluate(Ref(*a) - v, *out); },		[=](const size_t i) { return (*a)[i] - v; });
+		add_operator("vector-expr", [=] { Evaluate(v - Ref(*a), *out); },		[=](const size_t i) { return v - (*a)[i]; });
+		add_operator("expr*expr",	[=] { Evaluate(Ref(*a) * Ref(*b), *out); },	[=](const size_t i) { return (*a)[i] * (*b)[i]; });
+		add_operator("expr*vector", [=] { Evaluate(Ref(*a) * v, *out); },		[=](const size_t i) { return (*a)[i] * v; });
+		add_operator("vector*expr", [=] { Evaluate(v * Ref(*a), *out); },		[=](const size_t i) { return v * (*a)[i]; });
+		add_operator("expr*scale",	[=] { Evaluate(Ref(*a) * scale, *out); },	[=](const size_t i) { return (*a)[i] * scale; });
+		add_operator("scale*expr",	[=] { Evaluate(scale * Ref(*a), *out); },	[=](const size_t i) { return scale * (*a)[i]; });
+		add_operator("-expr",		[=] { Evaluate(-Ref(*a), *out); },			[=](const size_t i) { return -(*a)[i]; });
+	}
+
+	/// @brief Vector2DArrayの一括演算と、Vector2D配列をテンプレートの演算子で処理した場合を比較する
+	/// @brief Scale・GetDot・ClampToRectのsoaは、要素ごとのスカラーの規則で求めた結果との不一致数を記録する
+	template<Vector2DArrayElement ElemT>
+	inline void RegisterVector2DArrayBenchmarks(Suite& suite, const std::string& type_name)
+	{
+		using DotT = v2d::DotType<ElemT>;
+
+		constexpr size_t num   = 100000;
+		constexpr float  scale = 0.5f;
+
+		const auto to_elem = [](const std::vector<Vector2D<float>>& v)
+		{
+			std::vector<Vector2D<ElemT>> result(v.size());
+			for (size_t i = 0; i < v.size(); ++i) { result[i] = v[i]; }
+			return result;
+		};
+
+		const auto aos	= std::make_shared<std::vector<Vector2D<ElemT>>>(to_elem(CreateRandomVector2Ds(num, 9)));
+		const auto aos2 = std::make_shared<std::vector<Vector2D<ElemT>>>(to_elem(CreateRandomVector2Ds(num, 10)));
+		const auto aoso = std::make_shared<std::vector<Vector2D<ElemT>>>(num);
+		const auto aosf = std::make_shared<std::vector<Vector2D<float>>>(num);
+		const auto soa	= std::make_shared<Vector2DArray<ElemT>>();
+		const auto soa2 = std::make_shared<Vector2DArray<ElemT>>();
+		const auto soao = std::make_shared<Vector2DArray<ElemT>>(num);
+		const auto soaf = std::make_shared<Vector2DArray<float>>(num);
+		const auto fo	= std::make_shared<std::vector<float>>(num);
+		const auto dot	= std::make_shared<std::vector<DotT>>(num);
+		for (size_t i = 0; i < num; ++i) { soa->PushBack((*aos)[i]); soa2->PushBack((*aos2)[i]); }
+
+		const Vector2D<ElemT>	min_pos = { ElemT(-50), ElemT(-25) };
+		const Vector2D<ElemT>	max_pos = { ElemT(50),  ElemT(75) };
+		const Vector2D<float>	point	= { 12.0f, -34.0f };
+		const auto				prefix	= "vector_array_2d/" + type_name;
+
+		// soaの出力と要素ごとの規則で求めた値との不一致数
+		const auto mismatch = [](const auto get_out, const auto get_reference)
+		{
+			return [=]
+			{
+				size_t mismatch_num = 0;
+				for (size_t i = 0; i < num; ++i) { mismatch_num += get_out(i) != get_reference(i) ? 1 : 0; }
+				return nlohmann::json{ { "mismatch_num", mismatch_num } };
+			};
+		};
+
+		// 整数はfloatで乗算して0方向に切り捨て、int16_tは範囲外を飽和させる
+		const auto scale_elem = [](const ElemT e)
+		{
+			const auto f = static_cast<float>(e) * scale;
+			if constexpr (std::same_as<ElemT, int16_t>)	{ return simd::TruncToInt16(f); }
+			else										{ return static_cast<ElemT>(f); }
+		};
+
+		// 幅の広い型(DotType)に変換してから乗算する
+		const auto dot_elem = [](const Vector2D<ElemT>& v1, const Vector2D<ElemT>& v2)
+		{
+			return static_cast<DotT>(v1.x) * v2.x + static_cast<DotT>(v1.y) * v2.y;
+		};
+
+		suite.Add(prefix + "/Add/aos/100000", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*aoso)[i] = (*aos)[i] + (*aos2)[i]; }
+			DoNotOptimize(*aoso->data());
+		});
+
+		suite.Add(prefix + "/Add/soa/100000", num, [=]
+		{
+			v2d::Add(*soa, *soa2, *soao);
+			DoNotOptimize(*soao->GetX());
+		});
+
+		suite.Add(prefix + "/Scale/aos/100000", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*aoso)[i] = (*aos)[i] * scale; }
+			DoNotOptimize(*aoso->data());
+		});
+
+		suite.Add(prefix + "/Scale/soa/100000", num, [=]
+		{
+			v2d::Scale(*soa, scale, *soao);
+			DoNotOptimize(*soao->GetX());
+		}, mismatch([=](const size_t i) { return soao->Get(i); },
+					[=](const size_t i) { return Vector2D<ElemT>{ scale_elem((*aos)[i].x), scale_elem((*aos)[i].y) }; }));
+
+		// soaと同じ型(DotType)で求める
+		suite.Add(prefix + "/GetDot/aos/100000", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*dot)[i] = dot_elem((*aos)[i], (*aos2)[i]); }
+			DoNotOptimize(*dot->data());
+		});
+
+		suite.Add(prefix + "/GetDot/soa/100000", num, [=]
+		{
+			v2d::GetDot(*soa, *soa2, dot->data());
+			DoNotOptimize(*dot->data());
+		}, mismatch([=](const size_t i) { return (*dot)[i]; },
+					[=](const size_t i) { return dot_elem((*aos)[i], (*aos2)[i]); }));
+
+		suite.Add(prefix + "/GetSize/aos/100000", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*fo)[i] = v2d::GetSize((*aos)[i]); }
+			DoNotOptimize(*fo->data());
+		});
+
+		suite.Add(prefix + "/GetSize/soa/100000", num, [=]
+		{
+			v2d::GetSize(*soa, fo->data());
+			DoNotOptimize(*fo->data());
+		});
+
+		suite.Add(prefix + "/Normalize/aos/100000", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i)
+			{
+				Vector2D<float> v;
+				v = (*aos)[i];
+				(*aosf)[i] = v2d::GetNormalizedV(v);
+			}
+			DoNotOptimize(*aosf->data());
+		});
+
+		suite.Add(prefix + "/Normalize/soa/100000", num, [=]
+		{
+			v2d::Normalize(*soa, *soaf);
+			DoNotOptimize(*soaf->GetX());
+		});
+
+		suite.Add(prefix + "/ClampToRect/aos/100000", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i)
+			{
+				const auto& v = (*aos)[i];
+				(*aoso)[i] = { std::clamp(v.x, min_pos.x, max_pos.x), std::clamp(v.y, min_pos.y, max_pos.y) };
+			}
+			DoNotOptimize(*aoso->data());
+		});
+
+		suite.Add(prefix + "/ClampToRect/soa/100000", num, [=]
+		{
+			v2d::ClampToRect(*soa, min_pos, max_pos, *soao);
+			DoNotOptimize(*soao->GetX());
+		}, mismatch([=](const size_t i) { return soao->Get(i); }, [=](const size_t i)
+		{
+			const auto& v = (*aos)[i];
+			return Vector2D<ElemT>{ std::min(std::max(v.x, min_pos.x), max_pos.x), std::min(std::max(v.y, min_pos.y), max_pos.y) };
+		}));
+
+		suite.Add(prefix + "/GetDistance/aos/100000", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*fo)[i] = v2d::GetSize((*aos)[i] - point); }
+			DoNotOptimize(*fo->data());
+		});
+
+		suite.Add(prefix + "/GetDistance/soa/100000", num, [=]
+		{
+			v2d::GetDistance(*soa, point, fo->data());
+			DoNotOptimize(*fo->data());
+		});
+	}
+
+	/// @brief 固定小数点数(Fixed)の一括演算を、floatのVector2DArrayと比較する
+	/// @brief Fixedのケースはスカラー版との不一致数と出力のハッシュを記録する (どの環境でも不一致数0・同じハッシュになること)
+	inline void RegisterFixedPointBenchmarks(Suite& suite)
+	{
+		constexpr size_t num = 100000;
+
+		const auto src	= CreateRandomVector2Ds(num, 11);
+		const auto src2 = CreateRandomVector2Ds(num, 12);
+
+		const auto fv	= std::make_shared<Vector2DArray<float>>();
+		const auto fv2	= std::make_shared<Vector2DArray<float>>();
+		const auto fvo	= std::make_shared<Vector2DArray<float>>(num);
+		const auto xv	= std::make_shared<Vector2DArray<Fixed>>();
+		const auto xv2	= std::make_shared<Vector2DArray<Fixed>>();
+		const auto xvo	= std::make_shared<Vector2DArray<Fixed>>(num);
+		const auto fo	= std::make_shared<std::vector<float>>(num);
+		const auto xo	= std::make_shared<std::vector<Fixed>>(num);
+		for (size_t i = 0; i < num; ++i)
+		{
+			fv->PushBack(src[i]);
+			fv2->PushBack(src2[i]);
+			xv->PushBack({ Fixed::FromFloat(src[i].x),  Fixed::FromFloat(src[i].y) });
+			xv2->PushBack({ Fixed::FromFloat(src2[i].x), Fixed::FromFloat(src2[i].y) });
+		}
+
+		suite.Add("fixed_point/Add/float/100000", num, [=]
+		{
+			v2d::Add(*fv, *fv2, *fvo);
+			DoNotOptimize(*fvo->GetX());
+		});
+
+		suite.Add("fixed_point/Add/fixed/100000", num, [=]
+		{
+			v2d::Add(*xv, *xv2, *xvo);
+			DoNotOptimize(*xvo->GetX());
+		}, [=]
+		{
+			return GetFixedCheck<Vector2D<Fixed>>(num, [=](const size_t i) { return xvo->Get(i); }, [=](const size_t i) { return xv->Get(i) + xv2->Get(i); });
+		});
+
+		const Vector2D<float> min_pos = { -50.0f, -30.0f };
+		const Vector2D<float> max_pos = {  40.0f,  60.0f };
+		const Vector2D<Fixed> min_pos_fixed = { Fixed(-50), Fixed(-30) };
+		const Vector2D<Fixed> max_pos_fixed = { Fixed( 40), Fixed( 60) };
+
+		suite.Add("fixed_point/ClampToRect/float/100000", num, [=]
+		{
+			v2d::ClampToRect(*fv, min_pos, max_pos, *fvo);
+			DoNotOptimize(*fvo->GetX());
+		});
+
+		suite.Add("fixed_point/ClampToRect/fixed/100000", num, [=]
+		{
+			v2d::ClampToRect(*xv, min_pos_fixed, max_pos_fixed, *xvo);
+			DoNotOptimize(*xvo->GetX());
+		}, [=]
+		{
+			return GetFixedCheck<Vector2D<Fixed>>(num, [=](const size_t i) { return xvo->Get(i); }, [=](const size_t i)
+			{
+				const auto v = xv->Get(i);
+				return Vector2D<Fixed>{ std::clamp(v.x, min_pos_fixed.x, max_pos_fixed.x), std::clamp(v.y, min_pos_fixed.y, max_pos_fixed.y) };
+			});
+		});
+
+		suite.Add("fixed_point/GetDot/float/100000", num, [=]
+		{
+			v2d::GetDot(*fv, *fv2, fo->data());
+			DoNotOptimize(*fo->data());
+		});
+
+		suite.Add("fixed_point/GetDot/fixed/100000", num, [=]
+		{
+			v2d::GetDot(*xv, *xv2, xo->data());
+			DoNotOptimize(*xo->data());
+		}, [=]
+		{
+			return GetFixedCheck<Fixed>(num, [=](const size_t i) { return (*xo)[i]; }, [=](const size_t i) { return v2d::GetDot(xv->Get(i), xv2->Get(i)); });
+		});
+
+		suite.Add("fixed_point/GetSize/float/100000", num, [=]
+		{
+			v2d::GetSize(*fv, fo->data());
+			DoNotOptimize(*fo->data());
+		});
+
+		suite.Add("fixed_point/GetSize/fixed/100000", num, [=]
+		{
+			v2d::GetSize(*xv, xo->data());
+			DoNotOptimize(*xo->data());
+		}, [=]
+		{
+			return GetFixedCheck<Fixed>(num, [=](const size_t i) { return (*xo)[i]; }, [=](const size_t i) { return v2d::GetSize(xv->Get(i)); });
+		});
+
+		suite.Add("fixed_point/Normalize/float/100000", num, [=]
+		{
+			v2d::Normalize(*fv, *fvo);
+			DoNotOptimize(*fvo->GetX());
+		}, [=]
+		{
+			return GetNormalizeError(num, [=](const size_t i) { return VGet(fv->GetX()[i], fv->GetY()[i], 0.0f); }, [=](const size_t i) { return VGet(fvo->GetX()[i], fvo->GetY()[i], 0.0f); });
+		});
+
+		suite.Add("fixed_point/Normalize/fixed/100000", num, [=]
+		{
+			v2d::Normalize(*xv, *xvo);
+			DoNotOptimize(*xvo->GetX());
+		}, [=]
+		{
+			auto counters = GetNormalizeError(num, [=](const size_t i) { return VGet(xv->GetX()[i].ToFloat(), xv->GetY()[i].ToFloat(), 0.0f); }, [=](const size_t i) { return VGet(xvo->GetX()[i].ToFloat(), xvo->GetY()[i].ToFloat(), 0.0f); });
+			counters.update(GetFixedCheck<Vector2D<Fixed>>(num, [=](const size_t i) { return xvo->Get(i); }, [=](const size_t i) { return v2d::GetNormalizedV(xv->Get(i)); }));
+			return counters;
+		});
+
+		const Vector2D<float> point		  = { 12.5f, -7.25f };
+		const Vector2D<Fixed> point_fixed = { Fixed::FromFloat(point.x), Fixed::FromFloat(point.y) };
+
+		suite.Add("fixed_point/GetDistance/float/100000", num, [=]
+		{
+			v2d::GetDistance(*fv, point, fo->data());
+			DoNotOptimize(*fo->data());
+		});
+
+		suite.Add("fixed_point/GetDistance/fixed/100000", num, [=]
+		{
+			v2d::GetDistance(*xv, point_fixed, xo->data());
+			DoNotOptimize(*xo->data());
+		}, [=]
+		{
+			return GetFixedCheck<Fixed>(num, [=](const size_t i) { return (*xo)[i]; }, [=](const size_t i) { return v2d::GetSize(xv->Get(i) - point_fixed); });
+		});
+	}
+
+	inline void RegisterVectorBenchmarks(Suite& suite)
+	{
+		constexpr size_t num = 1024;
+
+		const auto v1 = std::make_shared<std::vector<VECTOR>>(CreateRandomVectors(num, 1));
+		const auto v2 = std::make_shared<std::vector<VECTOR>>(CreateRandomVectors(num, 2));
+		const auto vo = std::make_shared<std::vector<VECTOR>>(num);
+
+		suite.Add("vector_3d/operator+/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*vo)[i] = (*v1)[i] + (*v2)[i]; }
+			DoNotOptimize(*vo->data());
+		});
+
+		suite.Add("vector_3d/operator-/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*vo)[i] = (*v1)[i] - (*v2)[i]; }
+			DoNotOptimize(*vo->data());
+		});
+
+		suite.Add("vector_3d/operator*(VECTOR)/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*vo)[i] = (*v1)[i] * (*v2)[i]; }
+			DoNotOptimize(*vo->data());
+		});
+
+		suite.Add("vector_3d/operator*(float)/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*vo)[i] = (*v1)[i] * 0.5f; }
+			DoNotOptimize(*vo->data());
+		});
+
+		suite.Add("vector_3d/operator+=/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*vo)[i] += (*v1)[i]; }
+			DoNotOptimize(*vo->data());
+		});
+
+		suite.Add("vector_3d/operator==/1024", num, [=]
+		{
+			size_t count = 0;
+			for (size_t i = 0; i < num; ++i) { count += (*v1)[i] == (*v2)[i] ? 1 : 0; }
+			DoNotOptimize(count);
+		});
+
+		// 正規化 (精度別)
+		const auto normalize_error = [=]
+		{
+			return GetNormalizeError(num, [=](const size_t i) { return (*v1)[i]; }, [=](const size_t i) { return (*vo)[i]; });
+		};
+
+		suite.Add("vector_3d/GetNormalizedV/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*vo)[i] = v3d::GetNormalizedV((*v1)[i]); }
+			DoNotOptimize(*vo->data());
+		}, normalize_error);
+
+		suite.Add("vector_3d/GetNormalizedVFast/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*vo)[i] = v3d::GetNormalizedVFast((*v1)[i]); }
+			DoNotOptimize(*vo->data());
+		}, normalize_error);
+
+		suite.Add("vector_3d/GetNormalizedVApprox/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*vo)[i] = v3d::GetNormalizedVApprox((*v1)[i]); }
+			DoNotOptimize(*vo->data());
+		}, normalize_error);
+
+		// Vector2D
+		const auto w1 = std::make_shared<std::vector<Vector2D<float>>>(CreateRandomVector2Ds(num, 3));
+		const auto wo = std::make_shared<std::vector<Vector2D<float>>>(num);
+		const auto fo = std::make_shared<std::vector<float>>(num);
+
+		suite.Add("vector_2d/GetSize/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*fo)[i] = v2d::GetSize((*w1)[i]); }
+			DoNotOptimize(*fo->data());
+		});
+
+		const auto normalize_error_2d = [=]
+		{
+			return GetNormalizeError(num, [=](const size_t i) { return VGet((*w1)[i].x, (*w1)[i].y, 0.0f); }, [=](const size_t i) { return VGet((*wo)[i].x, (*wo)[i].y, 0.0f); });
+		};
+
+		suite.Add("vector_2d/GetNormalizedV/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*wo)[i] = v2d::GetNormalizedV((*w1)[i]); }
+			DoNotOptimize(*wo->data());
+		}, normalize_error_2d);
+
+		suite.Add("vector_2d/GetNormalizedVFast/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*wo)[i] = v2d::GetNormalizedVFast((*w1)[i]); }
+			DoNotOptimize(*wo->data());
+		}, normalize_error_2d);
+
+		suite.Add("vector_2d/GetNormalizedVApprox/1024", num, [=]
+		{
+			for (size_t i = 0; i < num; ++i) { (*wo)[i] = v2d::GetNormalizedVApprox((*w1)[i]); }
+			DoNotOptimize(*wo->data());
+		}, normalize_error_2d);
+
+		// Vector2D配列の連鎖演算 (a + b * s - c)
+		RegisterVector2DExpressionBenchmarks<float>(suite, "float");
+		RegisterVector2DExpressionBenchmarks<int>(suite, "int");
+
+		// Vector2DArray (SoA) とVector2D配列 (AoS) の比較
+		RegisterVector2DArrayBenchmarks<float>(suite, "float");
+		RegisterVector2DArrayBenchmarks<int32_t>(suite, "int32");
+		RegisterVector2DArrayBenchmarks<int16_t>(suite, "int16");
+		RegisterFixedPointBenchmarks(suite);
+
+		// VectorArray3 (SoA) とVECTOR配列 (AoS) の比較
+		constexpr size_t array_num = 100000;
+
+		const auto aos	= std::make_shared<std::vector<VECTOR>>(CreateRandomVectors(array_num, 4));
+		const auto aos2 = std::make_shared<std::vector<VECTOR>>(CreateRandomVectors(array_num, 5));
+		const auto aoso = std::make_shared<std::vector<VECTOR>>(array_num);
+		const auto soa	= std::make_shared<VectorArray3>();
+		const auto soa2 = std::make_shared<VectorArray3>();
+		const auto soao = std::make_shared<VectorArray3>(array_num);
+		for (size_t i = 0; i < array_num; ++i) { soa->PushBack((*aos)[i]); soa2->PushBack((*aos2)[i]); }
+
+		auto mat = MGetIdent();
+		mat.m[0][0] = 0.8f; mat.m[0][1] = 0.6f; mat.m[1][0] = -0.6f; mat.m[1][1] = 0.8f;
+		mat.m[3][0] = 10.0f; mat.m[3][1] = 5.0f; mat.m[3][2] = -3.0f;
+
+		suite.Add("vector_array_3d/Add/aos/100000", array_num, [=]
+		{
+			for (size_t i = 0; i < array_num; ++i) { (*aoso)[i] = (*aos)[i] + (*aos2)[i]; }
+			DoNotOptimize(*aoso->data());
+		});
+
+		suite.Add("vector_array_3d/Add/soa/100000", array_num, [=]
+		{
+			v3d::Add(*soa, *soa2, *soao);
+			DoNotOptimize(*soao->GetX());
+		});
+
+		suite.Add("vector_array_3d/Normalize/aos/100000", array_num, [=]
+		{
+			for (size_t i = 0; i < array_num; ++i) { (*aoso)[i] = v3d::GetNormalizedV((*aos)[i]); }
+			DoNotOptimize(*aoso->data());
+		});
+
+		const auto soa_normalize_error = [=]
+		{
+			return GetNormalizeError(array_num, [=](const size_t i) { return (*aos)[i]; }, [=](const size_t i) { return soao->Get(i); });
+		};
+
+		suite.Add("vector_array_3d/Normalize/soa/100000", array_num, [=]
+		{
+			v3d::Normalize(*soa, *soao);
+			DoNotOptimize(*soao->GetX());
+		}, soa_normalize_error);
+
+		suite.Add("vector_array_3d/NormalizeFast/soa/100000", array_num, [=]
+		{
+			v3d::NormalizeFast(*soa, *soao);
+			DoNotOptimize(*soao->GetX());
+		}, soa_normalize_error);
+
+		suite.Add("vector_array_3d/NormalizeApprox/soa/100000", array_num, [=]
+		{
+			v3d::NormalizeApprox(*soa, *soao);
+			DoNotOptimize(*soao->GetX());
+		}, soa_normalize_error);
+
+		suite.Add("vector_array_3d/Transform/aos/100000", array_num, [=]
+		{
+			for (size_t i = 0; i < array_num; ++i) { (*aoso)[i] = VTransform((*aos)[i], mat); }
+			DoNotOptimize(*aoso->data());
+		});
+
+		suite.Add("vector_array_3d/Transform/soa/100000", array_num, [=]
+		{
+			v3d::Transform(*soa, mat, *soao);
+			DoNotOptimize(*soao->GetX());
+		});
+	}
+}
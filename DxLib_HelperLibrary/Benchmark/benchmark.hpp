@@ -0,0 +1,213 @@
+﻿#pragma once
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <SIMD/simd.hpp>
+
+#if defined(__has_include)
+	#if __has_include(<sys/resource.h>) && __has_include(<sys/wait.h>) && __has_include(<unistd.h>)
+		#define DXLIB_HELPER_BENCHMARK_HAS_FORK 1
+		#include <sys/resource.h>
+		#include <sys/wait.h>
+		#include <unistd.h>
+	#endif
+#endif
+
+/// @brief ヘルパーライブラリ計測用の簡易ベンチマークハーネス
+/// @brief 計測結果はJSONで出力し、リリース間の差分比較に使用する
+namespace benchmark
+{
+	/// @brief 計算結果を最適化で消されないようにする
+	template<typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static_cast<void>(*reinterpret_cast<const volatile char*>(&value));
+#endif
+	}
+
+	/// @brief 1ケースの計測結果
+	struct Result
+	{
+		std::string name;
+		size_t		iterations;		// 計測に使用した反復回数
+		size_t		items;			// 1反復で処理する要素数
+		double		ns_per_iter;	// 1反復あたりの時間 (ナノ秒)
+		double		ns_per_item;	// 1要素あたりの時間 (ナノ秒)
+		nlohmann::json counters;	// ケース固有の追加情報
+	};
+
+	/// @brief 計測ケース
+	struct Case
+	{
+		std::string				name;
+		size_t					items;
+		std::function<void()>	func;
+		std::function<nlohmann::json()> counters;	// 計測後に呼び出し、結果に追加する (省略可)
+	};
+
+	/// @brief 使用しているSIMD命令セット名を取得
+	[[nodiscard]] inline const char* GetSimdName()
+	{
+#if defined(DXLIB_HELPER_SIMD_AVX)
+		return "AVX";
+#elif defined(DXLIB_HELPER_SIMD_SSE2)
+		return "SSE2";
+#else
+		return "Scalar";
+#endif
+	}
+
+	/// @brief 処理中に増加した最大常駐メモリ量を計測する
+	/// @brief 計測済みのメモリの影響を受けないよう、子プロセスで1回だけ実行する
+	/// @return 増加量 (KB)、計測できない環境では-1
+	[[nodiscard]] inline long long MeasurePeakMemoryGrowthKb(const std::function<void()>& func)
+	{
+#if defined(DXLIB_HELPER_BENCHMARK_HAS_FORK)
+		int fds[2];
+		if (pipe(fds) != 0) { return -1; }
+
+		const auto pid = fork();
+		if (pid < 0)
+		{
+			close(fds[0]);
+			close(fds[1]);
+			return -1;
+		}
+
+		if (pid == 0)
+		{
+			// 子プロセス : 実行前後の最大常駐メモリ量の差を親に送る
+			rusage usage {};
+			getrusage(RUSAGE_SELF, &usage);
+			const long long before = usage.ru_maxrss;
+
+			func();
+
+			getrusage(RUSAGE_SELF, &usage);
+			long long growth = usage.ru_maxrss - before;
+#if defined(__APPLE__)
+			growth /= 1024;	// macOSはバイト単位
+#endif
+			const auto written = write(fds[1], &growth, sizeof(growth));
+			static_cast<void>(written);
+			_exit(0);
+		}
+
+		close(fds[1]);
+		long long growth = -1;
+		if (read(fds[0], &growth, sizeof(growth)) != static_cast<ssize_t>(sizeof(growth))) { growth = -1; }
+		close(fds[0]);
+
+		int status = 0;
+		waitpid(pid, &status, 0);
+		return growth;
+#else
+		static_cast<void>(func);
+		return -1;
+#endif
+	}
+
+	/// @brief 計測ケースの集合
+	class Suite
+	{
+	public:
+		/// @brief 計測ケースを追加する
+		/// @param name ケース名 ("分類/関数名/条件" の形式)
+		/// @param items 1反復で処理する要素数
+		/// @param func 1反復分の処理
+		void Add(const std::string& name, const size_t items, std::function<void()> func, std::function<nlohmann::json()> counters = nullptr)
+		{
+			cases.push_back({ name, items, std::move(func), std::move(counters) });
+		}
+
+		/// @brief 計測ケースを実行する
+		/// @param filter ケース名に含まれる文字列 (空の場合は全ケース)
+		/// @param min_time_sec 1ケースの最小計測時間 (秒)
+		[[nodiscard]] std::vector<Result> Run(const std::string_view& filter, const double min_time_sec) const
+		{
+			std::vector<Result> results;
+			for (const auto& c : cases)
+			{
+				if (!filter.empty() && c.name.find(filter) == std::string::npos) { continue; }
+
+				results.emplace_back(Measure(c, min_time_sec));
+
+				const auto& result = results.back();
+				std::fprintf(stderr, "%-64s %14.2f ns/iter %12.3f ns/item %12zu iters\n", result.name.c_str(), result.ns_per_iter, result.ns_per_item, result.iterations);
+			}
+			return results;
+		}
+
+		/// @brief 計測結果をJSONに変換する
+		[[nodiscard]] static nlohmann::json ToJson(const std::vector<Result>& results)
+		{
+			nlohmann::json j_results = nlohmann::json::array();
+			for (const auto& result : results)
+			{
+				nlohmann::json j_result =
+				{
+					{ "name",			result.name },
+					{ "iterations",		result.iterations },
+					{ "items",			result.items },
+					{ "ns_per_iter",	result.ns_per_iter },
+					{ "ns_per_item",	result.ns_per_item }
+				};
+				if (!result.counters.is_null()) { j_result["counters"] = result.counters; }
+
+				j_results.emplace_back(std::move(j_result));
+			}
+
+			return
+			{
+				{ "simd",		GetSimdName() },
+				{ "results",	j_results }
+			};
+		}
+
+	private:
+		/// @brief 計測時間が最小計測時間を超えるまで反復回数を増やして計測する
+		[[nodiscard]] static Result Measure(const Case& c, const double min_time_sec)
+		{
+			using Clock = std::chrono::steady_clock;
+
+			// キャッシュ等を温める
+			c.func();
+
+			size_t iterations = 1;
+			while (true)
+			{
+				const auto begin = Clock::now();
+				for (size_t i = 0; i < iterations; ++i) { c.func(); }
+				const auto elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+
+				if (elapsed >= min_time_sec || iterations >= (size_t(1) << 40))
+				{
+					const auto ns_per_iter = elapsed * 1e9 / static_cast<double>(iterations);
+					return
+					{
+						c.name,
+						iterations,
+						c.items,
+						ns_per_iter,
+						ns_per_iter / static_cast<double>(c.items == 0 ? 1 : c.items),
+						c.counters ? c.counters() : nlohmann::json()
+					};
+				}
+
+				// 目標時間に届く反復回数を見積もる (最大10倍まで)
+				const auto scale = elapsed > 0.0 ? min_time_sec * 1.2 / elapsed : 10.0;
+				iterations = static_cast<size_t>(static_cast<double>(iterations) * (scale > 10.0 ? 10.0 : (scale < 2.0 ? 2.0 : scale)));
+			}
+		}
+
+		std::vector<Case> cases;
+	};
+}
@@ -0,0 +1,56 @@
+﻿/// @brief ヘルパーライブラリのマイクロベンチマーク
+/// @brief ヘッドレス環境でのビルド例 (リポジトリのルートで実行する) :
+/// @brief   g++ -std=c++20 -O2 -DDXLIB_HELPER_HEADLESS -IDxLib_HelperLibrary DxLib_HelperLibrary/Benchmark/benchmark_main.cpp -o helper_benchmark -pthread
+/// @brief 引数 :
+/// @brief   --filter=<文字列>	ケース名にこの文字列を含むケースのみ実行する
+/// @brief   --min-time=<秒>	1ケースの最小計測時間 (初期値 : 0.2)
+/// @brief   --out=<パス>		計測結果のJSONをファイルに出力する (省略時は標準出力)
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <Benchmark/benchmark.hpp>
+#include <Benchmark/bench_vector.hpp>
+#include <Benchmark/bench_matrix.hpp>
+#include <Benchmark/bench_mixamo.hpp>
+#include <Benchmark/bench_json.hpp>
+
+int main(int argc, char* argv[])
+{
+	std::string filter;
+	std::string out_path;
+	double		min_time_sec = 0.2;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string_view arg = argv[i];
+		if		(arg.rfind("--filter=",	  0) == 0) { filter		  = arg.substr(9); }
+		else if (arg.rfind("--min-time=", 0) == 0) { min_time_sec = std::atof(std::string(arg.substr(11)).c_str()); }
+		else if (arg.rfind("--out=",	  0) == 0) { out_path	  = arg.substr(6); }
+		else
+		{
+			std::cerr << "unknown argument : " << arg << "\n";
+			return EXIT_FAILURE;
+		}
+	}
+
+	benchmark::Suite suite;
+	benchmark::RegisterVectorBenchmarks(suite);
+	benchmark::RegisterMatrixBenchmarks(suite);
+	benchmark::RegisterMixamoBenchmarks(suite);
+	benchmark::RegisterJsonBenchmarks(suite);
+
+	const auto results = suite.Run(filter, min_time_sec);
+	const auto j_data  = benchmark::Suite::ToJson(results);
+
+	if (out_path.empty())
+	{
+		std::cout << j_data.dump(2) << std::endl;
+		return EXIT_SUCCESS;
+	}
+
+	std::ofstream ofs(out_path);
+	if (!ofs) { return EXIT_FAILURE; }
+
+	ofs << j_data.dump(2) << std::endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,222 @@
+﻿#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <utility>
+#include <nlohmann/json.hpp>
+#include <Vector/vector_2d.hpp>
+
+/// @brief 符号付きQ16.16の固定小数点数 (整数部16bit、小数部16bit)
+/// @brief 整数演算のみで計算するため、コンパイラや最適化設定によらずビット単位で同じ結果になる (リプレイ・ロックステップ用)
+/// @brief 加減算の桁あふれは2の補数で折り返し、乗算は64bitで計算して負の無限大方向に、除算は0方向に丸める
+struct Fixed
+{
+	static constexpr int	 kFractionBits	= 16;
+	static constexpr int32_t kOneRaw		= 1 << kFractionBits;
+
+	int32_t raw = 0;	// 値 * 2^16
+
+	constexpr Fixed() = default;
+
+	/// @brief 整数値から生成 (-32768 ~ 32767。範囲外は表せる最小値・最大値に飽和する)
+	template<std::integral T>
+	explicit constexpr Fixed(const T value) :
+		raw(std::cmp_less   (value, INT32_MIN >> kFractionBits) ? INT32_MIN :
+			std::cmp_greater(value, INT32_MAX >> kFractionBits) ? INT32_MAX :
+			static_cast<int32_t>(static_cast<int64_t>(value) * kOneRaw)) {}
+
+	/// @brief 内部表現から生成
+	[[nodiscard]] static constexpr Fixed FromRaw(const int32_t raw)
+	{
+		Fixed f;
+		f.raw = raw;
+		return f;
+	}
+
+	/// @brief 浮動小数点数から生成 (最も近い値に丸める。範囲外は最小値・最大値に飽和し、NaNは0)
+	/// @brief データの読み込み時などに使用し、シミュレーション中の計算には使用しないこと
+	[[nodiscard]] static constexpr Fixed FromFloat(const double value)
+	{
+		if (value != value) { return Fixed(); }
+
+		// 0方向に切り捨てた結果がint32に収まる範囲 (-2^31 - 1, 2^31) 以外は飽和させる
+		const double rounded = value * kOneRaw + (value < 0.0 ? -0.5 : 0.5);
+		if (rounded >=  2147483648.0) { return FromRaw(INT32_MAX); }
+		if (rounded <= -2147483649.0) { return FromRaw(INT32_MIN); }
+		return FromRaw(static_cast<int32_t>(rounded));
+	}
+
+	/// @brief 描画などに使用する浮動小数点数への変換
+	[[nodiscard]] constexpr double	ToDouble() const { return static_cast<double>(raw) / kOneRaw; }
+	[[nodiscard]] constexpr float	ToFloat () const { return static_cast<float>(ToDouble()); }
+	explicit constexpr operator float() const { return ToFloat(); }
+
+	/// @brief 整数部 (負の無限大方向に切り捨て)
+	[[nodiscard]] constexpr int32_t ToInt() const { return raw >> kFractionBits; }
+
+	constexpr Fixed  operator+() const { return *this; }
+	constexpr Fixed  operator-() const { return FromRaw(static_cast<int32_t>(0u - static_cast<uint32_t>(raw))); }
+
+	constexpr Fixed& operator+=(const Fixed f) { raw = static_cast<int32_t>(static_cast<uint32_t>(raw) + static_cast<uint32_t>(f.raw)); return *this; }
+	constexpr Fixed& operator-=(const Fixed f) { raw = static_cast<int32_t>(static_cast<uint32_t>(raw) - static_cast<uint32_t>(f.raw)); return *this; }
+	constexpr Fixed& operator*=(const Fixed f) { raw = static_cast<int32_t>((static_cast<int64_t>(raw) * f.raw) >> kFractionBits); return *this; }
+
+	/// @brief fが0の場合の結果は未定義 (呼び出し側で避けること)
+	constexpr Fixed& operator/=(const Fixed f) { raw = static_cast<int32_t>(static_cast<int64_t>(raw) * kOneRaw / f.raw); return *this; }
+
+	template<std::integral T>
+	constexpr Fixed& operator*=(const T scale) { raw = static_cast<int32_t>(static_cast<int64_t>(raw) * scale); return *this; }
+
+	friend constexpr bool operator== (const Fixed&, const Fixed&) = default;
+	friend constexpr auto operator<=>(const Fixed&, const Fixed&) = default;
+};
+
+constexpr Fixed operator+(Fixed f1, const Fixed f2) { return f1 += f2; }
+constexpr Fixed operator-(Fixed f1, const Fixed f2) { return f1 -= f2; }
+constexpr Fixed operator*(Fixed f1, const Fixed f2) { return f1 *= f2; }
+constexpr Fixed operator/(Fixed f1, const Fixed f2) { return f1 /= f2; }
+
+template<std::integral T>
+constexpr Fixed operator*(Fixed f, const T scale) { return f *= scale; }
+
+template<std::integral T>
+constexpr Fixed operator*(const T scale, Fixed f) { return f *= scale; }
+
+
+namespace fixed
+{
+	namespace detail
+	{
+		/// @brief 64bit符号なし整数の平方根 (切り捨て)
+		/// @brief 上位の桁から1桁(2bit)ずつ決める開平法。低速なため初期値テーブルの生成にのみ使用する
+		[[nodiscard]] constexpr uint32_t Sqrt64Bitwise(uint64_t value)
+		{
+			if (value == 0) { return 0; }
+
+			uint64_t bit	= uint64_t(1) << ((63 - std::countl_zero(value)) & ~1);
+			uint64_t result = 0;
+			while (bit != 0)
+			{
+				if (value >= result + bit)
+				{
+					value -= result + bit;
+					result = (result >> 1) + bit;
+				}
+				else
+				{
+					result >>= 1;
+				}
+				bit >>= 2;
+			}
+			return static_cast<uint32_t>(result);
+		}
+
+		/// @brief 上位8bitが[64, 255]の値の平方根の初期値 (各区間の中央の平方根 / 2^16)
+		inline constexpr auto kSqrtSeedTable = []
+		{
+			std::array<uint16_t, 192> table{};
+			for (uint64_t i = 0; i < table.size(); ++i) { table[i] = static_cast<uint16_t>(Sqrt64Bitwise(((i + 64) * 2 + 1) << 23)); }
+			return table;
+		}();
+	}
+
+	/// @brief 64bit符号なし整数の平方根 (切り捨て)
+	/// @brief テーブルの初期値(約8bit精度)からニュートン法2回で求め、最後に整数で切り捨て値に補正する
+	/// @brief 整数演算のみのため、どの環境でも同じ結果になる
+	[[nodiscard]] constexpr uint32_t Sqrt64(const uint64_t value)
+	{
+		if (value == 0) { return 0; }
+
+		// 最上位の2bitに値が入るよう偶数ビット左シフトして正規化する
+		const auto shift	  = std::countl_zero(value) & ~1;
+		const auto normalized = value << shift;
+
+		auto x = static_cast<uint64_t>(detail::kSqrtSeedTable[(normalized >> 56) - 64]) << 16;
+		x = (x + normalized / x) >> 1;
+		x = (x + normalized / x) >> 1;
+
+		auto result = std::min<uint64_t>(x >> (shift / 2), UINT32_MAX);
+		while (result * result > value) { --result; }
+		if (result < UINT32_MAX && (result + 1) * (result + 1) <= value) { ++result; }
+		return static_cast<uint32_t>(result);
+	}
+
+	/// @brief 64bitの値をint32_tの範囲に収める
+	[[nodiscard]] constexpr int32_t SaturateToRaw(const int64_t raw)
+	{
+		return raw > INT32_MAX ? INT32_MAX : raw < INT32_MIN ? INT32_MIN : static_cast<int32_t>(raw);
+	}
+
+	/// @brief 平方根 (切り捨て。0以下の場合は0)
+	[[nodiscard]] constexpr Fixed Sqrt(const Fixed f)
+	{
+		return f.raw > 0 ? Fixed::FromRaw(static_cast<int32_t>(Sqrt64(static_cast<uint64_t>(f.raw) << Fixed::kFractionBits))) : Fixed();
+	}
+}
+
+
+/// @brief Vector2D<Fixed>の演算
+/// @brief v2dの浮動小数点数版と同じ名前で、整数演算のみで求める
+namespace v2d
+{
+	/// @brief x * x + y * y をQ32.32(64bit)で求める (丸めなし)
+	[[nodiscard]] constexpr uint64_t GetSquareSizeRaw(const Vector2D<Fixed>& v)
+	{
+		return static_cast<uint64_t>(static_cast<int64_t>(v.x.raw) * v.x.raw) + static_cast<uint64_t>(static_cast<int64_t>(v.y.raw) * v.y.raw);
+	}
+
+	/// @brief 長さの2乗 (範囲外は飽和)
+	[[nodiscard]] constexpr Fixed GetSquareSize(const Vector2D<Fixed>& v)
+	{
+		const auto square_size = GetSquareSizeRaw(v) >> Fixed::kFractionBits;
+		return Fixed::FromRaw(square_size > INT32_MAX ? INT32_MAX : static_cast<int32_t>(square_size));
+	}
+
+	/// @brief 長さ (切り捨て。範囲外は飽和)
+	[[nodiscard]] constexpr Fixed GetSize(const Vector2D<Fixed>& v)
+	{
+		const auto size = fixed::Sqrt64(GetSquareSizeRaw(v));
+		return Fixed::FromRaw(size > INT32_MAX ? INT32_MAX : static_cast<int32_t>(size));
+	}
+
+	/// @brief 内積 (積の和を64bitで求めてから1回だけ丸める。範囲外は飽和)
+	[[nodiscard]] constexpr Fixed GetDot(const Vector2D<Fixed>& v1, const Vector2D<Fixed>& v2)
+	{
+		const auto dot = static_cast<int64_t>(v1.x.raw) * v2.x.raw + static_cast<int64_t>(v1.y.raw) * v2.y.raw;
+		return Fixed::FromRaw(fixed::SaturateToRaw(dot >> Fixed::kFractionBits));
+	}
+
+	/// @brief 正規化したベクトルを取得 (長さが0の場合はそのまま返す)
+	/// @brief 長さの2乗を桁あふれしない範囲で左シフトしてから開平し、短いベクトルでも長さの精度を保つ
+	/// @brief 成分の誤差は2^-16程度 (0方向に丸める)
+	[[nodiscard]] constexpr Vector2D<Fixed> GetNormalizedV(const Vector2D<Fixed>& v)
+	{
+		const auto square_size = GetSquareSizeRaw(v);
+		if (square_size == 0) { return v; }
+
+		// square_size << shift が2^63未満に収まる最大の偶数
+		const auto shift	 = std::countl_zero(square_size) > 1 ? (std::countl_zero(square_size) - 1) & ~1 : 0;
+		const auto size		 = static_cast<int64_t>(fixed::Sqrt64(square_size << shift));	// 長さ * 2^(16 + shift / 2)
+		const auto numerator = int64_t(1) << (Fixed::kFractionBits + shift / 2);
+
+		return { Fixed::FromRaw(static_cast<int32_t>(v.x.raw * numerator / size)), Fixed::FromRaw(static_cast<int32_t>(v.y.raw * numerator / size)) };
+	}
+}
+
+
+#pragma region from / to JSON
+/// @brief 数値として読み込み、最も近い固定小数点数に丸める
+inline void from_json(const nlohmann::json& data, Fixed& f)
+{
+	f = Fixed::FromFloat(data.get<double>());
+}
+
+/// @brief Q16.16の値はdoubleで正確に表せるため、読み込み直しても同じ値になる
+inline void to_json(nlohmann::json& data, const Fixed& f)
+{
+	data = f.ToDouble();
+}
+#pragma endregion
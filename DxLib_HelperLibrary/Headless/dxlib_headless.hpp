@@ -0,0 +1,324 @@
+﻿#pragma once
+#include <climits>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/// @brief DxLibを使用できない環境(Linuxのビルド・ベンチマーク環境など)向けの代替ヘッダー
+/// @brief DXLIB_HELPER_HEADLESS を定義すると、各ヘッダーは<DxLib.h>の代わりにこのヘッダーを読み込む
+/// @brief 数学関数はDxLibと同じ結果を返し、描画関数は呼び出しを記録するのみで何も描画しない
+/// @brief MV1系の関数はheadless::CreateModelで登録した仮想モデルを参照する
+
+#ifndef TRUE
+	#define TRUE  1
+#endif
+#ifndef FALSE
+	#define FALSE 0
+#endif
+
+namespace DxLib
+{
+	struct VECTOR
+	{
+		float x;
+		float y;
+		float z;
+	};
+
+	struct MATRIX
+	{
+		float m[4][4];
+	};
+
+#pragma region ベクトル
+	inline VECTOR VGet		(const float x, const float y, const float z)	{ return { x, y, z }; }
+	inline VECTOR VAdd		(const VECTOR in1, const VECTOR in2)			{ return { in1.x + in2.x, in1.y + in2.y, in1.z + in2.z }; }
+	inline VECTOR VSub		(const VECTOR in1, const VECTOR in2)			{ return { in1.x - in2.x, in1.y - in2.y, in1.z - in2.z }; }
+	inline VECTOR VScale	(const VECTOR in, const float scale)			{ return { in.x * scale, in.y * scale, in.z * scale }; }
+	inline float  VDot		(const VECTOR in1, const VECTOR in2)			{ return in1.x * in2.x + in1.y * in2.y + in1.z * in2.z; }
+	inline VECTOR VCross	(const VECTOR in1, const VECTOR in2)			{ return { in1.y * in2.z - in1.z * in2.y, in1.z * in2.x - in1.x * in2.z, in1.x * in2.y - in1.y * in2.x }; }
+	inline float  VSquareSize(const VECTOR in)								{ return VDot(in, in); }
+	inline float  VSize		(const VECTOR in)								{ return std::sqrt(VSquareSize(in)); }
+
+	inline VECTOR VNorm(const VECTOR in)
+	{
+		const auto size = VSize(in);
+		return { in.x / size, in.y / size, in.z / size };
+	}
+
+	inline VECTOR VTransform(const VECTOR in, const MATRIX in_m)
+	{
+		const auto& m = in_m.m;
+		return {
+			in.x * m[0][0] + in.y * m[1][0] + in.z * m[2][0] + m[3][0],
+			in.x * m[0][1] + in.y * m[1][1] + in.z * m[2][1] + m[3][1],
+			in.x * m[0][2] + in.y * m[1][2] + in.z * m[2][2] + m[3][2]
+		};
+	}
+#pragma endregion
+
+#pragma region 行列
+	inline MATRIX MGetIdent()
+	{
+		return { {
+			{ 1.0f, 0.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.0f, 0.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f, 0.0f },
+			{ 0.0f, 0.0f, 0.0f, 1.0f }
+		} };
+	}
+
+	inline MATRIX MMult(const MATRIX in1, const MATRIX in2)
+	{
+		MATRIX result;
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				result.m[i][j] = in1.m[i][0] * in2.m[0][j] + in1.m[i][1] * in2.m[1][j] + in1.m[i][2] * in2.m[2][j] + in1.m[i][3] * in2.m[3][j];
+			}
+		}
+		return result;
+	}
+
+	inline MATRIX MAdd(MATRIX in1, const MATRIX in2)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				in1.m[i][j] += in2.m[i][j];
+			}
+		}
+		return in1;
+	}
+
+	inline MATRIX MScale(MATRIX in, const float scale)
+	{
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				in.m[i][j] *= scale;
+			}
+		}
+		return in;
+	}
+
+	/// @brief 回転・スケール成分のみを取り出す (座標成分は0)
+	inline MATRIX MGetRotElem(MATRIX in)
+	{
+		in.m[0][3] = 0.0f;
+		in.m[1][3] = 0.0f;
+		in.m[2][3] = 0.0f;
+		in.m[3][0] = 0.0f;
+		in.m[3][1] = 0.0f;
+		in.m[3][2] = 0.0f;
+		in.m[3][3] = 1.0f;
+		return in;
+	}
+
+	inline VECTOR MGetTranslateElem(const MATRIX in) { return { in.m[3][0], in.m[3][1], in.m[3][2] }; }
+#pragma endregion
+
+	namespace headless
+	{
+		/// @brief 記録対象の描画関数
+		enum class DrawType
+		{
+			kLine3D,
+			kSphere3D,
+			kCone3D,
+			kString,
+		};
+
+		/// @brief 描画関数の呼び出し内容
+		struct DrawCall
+		{
+			DrawType		type;
+			VECTOR			pos1;
+			VECTOR			pos2;
+			float			radius;
+			unsigned int	color;
+		};
+
+		/// @brief 描画関数の呼び出し記録
+		struct DrawRecord
+		{
+			size_t					line_count		= 0;
+			size_t					sphere_count	= 0;
+			size_t					cone_count		= 0;
+			size_t					string_count	= 0;
+			bool					is_record_calls	= false;	// trueの場合、呼び出し内容をcallsに記録する
+			std::vector<DrawCall>	calls;
+		};
+
+		/// @brief 仮想モデル
+		struct Model
+		{
+			bool					 is_valid = true;
+			std::vector<std::string> frame_names;
+			std::vector<int>		 parent_indices;
+			std::vector<MATRIX>		 local_world_matrices;
+		};
+
+		/// @brief 仮想モデルのハンドルの開始値 (DxLibのハンドルと同様に0以外の値とする)
+		constexpr int kModelHandleBase = 0x10000;
+
+		[[nodiscard]] inline DrawRecord& GetDrawRecord()
+		{
+			static DrawRecord record;
+			return record;
+		}
+
+		/// @brief 描画関数の呼び出し記録を消去する (記録するかどうかの設定は維持する)
+		inline void ResetDrawRecord()
+		{
+			auto& record = GetDrawRecord();
+			const auto is_record_calls = record.is_record_calls;
+			record = DrawRecord();
+			record.is_record_calls = is_record_calls;
+		}
+
+		[[nodiscard]] inline std::vector<Model>& GetModels()
+		{
+			static std::vector<Model> models;
+			return models;
+		}
+
+		/// @brief ハンドルから仮想モデルを取得する
+		/// @return 仮想モデル (無効なハンドルの場合はnullptr)
+		[[nodiscard]] inline Model* FindModel(const int model_handle)
+		{
+			auto&	   models = GetModels();
+			const auto index  = model_handle - kModelHandleBase;
+			if (index < 0 || index >= static_cast<int>(models.size()) || !models[index].is_valid) { return nullptr; }
+
+			return &models[index];
+		}
+
+		/// @brief 仮想モデルを登録する
+		/// @param frame_names フレーム名
+		/// @param parent_indices 親フレームのインデックス (ルートは-1)
+		/// @return モデルハンドル (全フレームの行列は単位行列で初期化される)
+		[[nodiscard]] inline int CreateModel(const std::vector<std::string>& frame_names, const std::vector<int>& parent_indices)
+		{
+			auto& models = GetModels();
+			models.push_back({ true, frame_names, parent_indices, std::vector<MATRIX>(frame_names.size(), MGetIdent()) });
+			return kModelHandleBase + static_cast<int>(models.size()) - 1;
+		}
+
+		/// @brief 仮想モデルのフレームのワールド行列を設定する
+		inline void SetFrameLocalWorldMatrix(const int model_handle, const int frame_index, const MATRIX& mat)
+		{
+			const auto model = FindModel(model_handle);
+			if (!model || frame_index < 0 || frame_index >= static_cast<int>(model->local_world_matrices.size())) { return; }
+
+			model->local_world_matrices[frame_index] = mat;
+		}
+
+		inline void Record(const DrawType type, const VECTOR& pos1, const VECTOR& pos2, const float radius, const unsigned int color)
+		{
+			auto& record = GetDrawRecord();
+			switch (type)
+			{
+			case DrawType::kLine3D:		++record.line_count;	break;
+			case DrawType::kSphere3D:	++record.sphere_count;	break;
+			case DrawType::kCone3D:		++record.cone_count;	break;
+			case DrawType::kString:		++record.string_count;	break;
+			}
+
+			if (record.is_record_calls) { record.calls.push_back({ type, pos1, pos2, radius, color }); }
+		}
+	}
+
+#pragma region 描画
+	inline unsigned int GetColor(const int red, const int green, const int blue)
+	{
+		return (static_cast<unsigned int>(red) << 16) | (static_cast<unsigned int>(green) << 8) | static_cast<unsigned int>(blue);
+	}
+
+	inline int DrawLine3D(const VECTOR pos1, const VECTOR pos2, const unsigned int color)
+	{
+		headless::Record(headless::DrawType::kLine3D, pos1, pos2, 0.0f, color);
+		return 0;
+	}
+
+	inline int DrawSphere3D(const VECTOR center_pos, const float r, const int, const unsigned int dif_color, const unsigned int, const int)
+	{
+		headless::Record(headless::DrawType::kSphere3D, center_pos, center_pos, r, dif_color);
+		return 0;
+	}
+
+	inline int DrawCone3D(const VECTOR top_pos, const VECTOR bottom_pos, const float r, const int, const unsigned int dif_color, const unsigned int, const int)
+	{
+		headless::Record(headless::DrawType::kCone3D, top_pos, bottom_pos, r, dif_color);
+		return 0;
+	}
+
+	inline int DrawFormatString(const int x, const int y, const unsigned int color, const char*, ...)
+	{
+		const auto pos = VGet(static_cast<float>(x), static_cast<float>(y), 0.0f);
+		headless::Record(headless::DrawType::kString, pos, pos, 0.0f, color);
+		return 0;
+	}
+#pragma endregion
+
+#pragma region モデル
+	inline int MV1GetFrameNum(const int m_handle)
+	{
+		const auto model = headless::FindModel(m_handle);
+		return model ? static_cast<int>(model->frame_names.size()) : -1;
+	}
+
+	inline int MV1SearchFrame(const int m_handle, const char* frame_name)
+	{
+		const auto model = headless::FindModel(m_handle);
+		if (!model) { return -2; }
+
+		// DxLibと同じくフレーム名を先頭から線形に比較する
+		const auto frame_num = static_cast<int>(model->frame_names.size());
+		for (int i = 0; i < frame_num; ++i)
+		{
+			if (model->frame_names[i] == frame_name) { return i; }
+		}
+		return -1;
+	}
+
+	inline const char* MV1GetFrameName(const int m_handle, const int frame_index)
+	{
+		const auto model = headless::FindModel(m_handle);
+		if (!model || frame_index < 0 || frame_index >= static_cast<int>(model->frame_names.size())) { return nullptr; }
+
+		return model->frame_names[frame_index].c_str();
+	}
+
+	inline int MV1GetFrameParent(const int m_handle, const int frame_index)
+	{
+		const auto model = headless::FindModel(m_handle);
+		if (!model || frame_index < 0 || frame_index >= static_cast<int>(model->parent_indices.size())) { return -2; }
+
+		return model->parent_indices[frame_index];
+	}
+
+	inline MATRIX MV1GetFrameLocalWorldMatrix(const int m_handle, const int frame_index)
+	{
+		const auto model = headless::FindModel(m_handle);
+		if (!model || frame_index < 0 || frame_index >= static_cast<int>(model->local_world_matrices.size())) { return MGetIdent(); }
+
+		return model->local_world_matrices[frame_index];
+	}
+
+	inline int MV1DeleteModel(const int m_handle)
+	{
+		const auto model = headless::FindModel(m_handle);
+		if (!model) { return -1; }
+
+		*model = headless::Model();
+		model->is_valid = false;
+		return 0;
+	}
+#pragma endregion
+}
+
+using namespace DxLib;
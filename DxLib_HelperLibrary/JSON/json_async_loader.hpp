@@ -0,0 +1,320 @@
+﻿#pragma once
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <JSON/json_loader.hpp>
+
+namespace json_loader
+{
+	/// @brief 非同期読み込みの優先度
+	enum class Priority
+	{
+		kHigh,
+		kNormal,
+		kLow,
+	};
+
+	/// @brief 非同期読み込みの結果
+	enum class LoadStatus
+	{
+		kSuccess,	// 読み込み成功
+		kFailed,	// 読み込み失敗 (ファイルが開けない・解析エラー)
+		kCanceled,	// キャンセルされた
+		kRejected,	// キューが満杯、または停止中のため受け付けられなかった
+	};
+
+	/// @brief 非同期読み込みの結果とデータ
+	struct LoadResult
+	{
+		LoadStatus		status = LoadStatus::kFailed;
+		nlohmann::json	data;
+	};
+
+	/// @brief 読み込み完了時に呼び出す関数
+	using LoadCallback = std::function<void(LoadResult& result)>;
+
+	/// @brief 読み込み要求の識別子 (0は無効)
+	using RequestId = std::uint64_t;
+	inline constexpr RequestId kInvalidRequestId = 0;
+
+	/// @brief ワーカースレッドでJSONファイルを読み込む非同期ローダー
+	/// @brief 要求は優先度の高い順、同じ優先度では要求順に処理される
+	/// @brief コールバックはワーカースレッドではなく、DispatchCallbacksを呼び出したスレッドで実行される
+	class AsyncLoader
+	{
+	public:
+		/// @param thread_num ワーカースレッド数 (0の場合はハードウェアスレッド数の半分)
+		/// @param max_queue_size 待機できる要求の最大数。超えた要求はkRejectedになる
+		explicit AsyncLoader(const size_t thread_num = 0, const size_t max_queue_size = 256) :
+			max_queue_size(max_queue_size)
+		{
+			const auto num = thread_num != 0 ? thread_num : std::max<size_t>(1, std::thread::hardware_concurrency() / 2);
+
+			workers.reserve(num);
+			for (size_t i = 0; i < num; ++i) { workers.emplace_back([this] { WorkerLoop(); }); }
+		}
+
+		/// @brief 待機中の要求をキャンセルし、実行中の読み込みの完了を待って終了する
+		/// @brief 未実行のコールバックは破棄される
+		~AsyncLoader()
+		{
+			{
+				std::lock_guard lock(mutex);
+				is_stopped = true;
+			}
+			CancelAll();
+			queue_cv.notify_all();
+
+			for (auto& worker : workers) { worker.join(); }
+		}
+
+		AsyncLoader(const AsyncLoader&)				= delete;
+		AsyncLoader& operator=(const AsyncLoader&)	= delete;
+
+		/// @brief 読み込みを要求し、完了時にコールバックを呼び出す
+		/// @param callback DispatchCallbacksで呼び出される関数 (キャンセル・拒否時も呼び出される)
+		/// @return 要求の識別子 (拒否された場合はkInvalidRequestId)
+		RequestId Request(const std::string_view& file_path, LoadCallback callback, const Priority priority = Priority::kNormal, const Format format = Format::kAuto)
+		{
+			auto complete = [this, callback = std::move(callback)](LoadResult&& result) mutable
+			{
+				std::lock_guard lock(callback_mutex);
+				completed.emplace_back(std::move(callback), std::move(result));
+			};
+
+			return Enqueue(file_path, std::move(complete), priority, format);
+		}
+
+		/// @brief 読み込みを要求し、結果をfutureで受け取る
+		/// @param out_id 要求の識別子の出力先 (キャンセルに使用。不要な場合はnullptr)
+		[[nodiscard]] std::future<LoadResult> RequestFuture(const std::string_view& file_path, RequestId* out_id = nullptr, const Priority priority = Priority::kNormal, const Format format = Format::kAuto)
+		{
+			auto promise = std::make_shared<std::promise<LoadResult>>();
+			auto future  = promise->get_future();
+
+			const auto id = Enqueue(file_path, [promise](LoadResult&& result) { promise->set_value(std::move(result)); }, priority, format);
+			if (out_id) { *out_id = id; }
+
+			return future;
+		}
+
+		/// @brief 要求をキャンセルする
+		/// @brief 待機中の要求は読み込まれずに、実行中の要求は読み込み完了後にkCanceledとして完了する
+		/// @return true : キャンセルした, false : 該当する要求がない (完了済み)
+		bool Cancel(const RequestId id)
+		{
+			Job job;
+			{
+				std::lock_guard lock(mutex);
+
+				// 実行中
+				if (const auto it = running.find(id); it != running.end())
+				{
+					it->second = true;
+					return true;
+				}
+
+				// 待機中
+				if (!TakeQueued(id, job)) { return false; }
+			}
+
+			job.complete({ LoadStatus::kCanceled, {} });
+			idle_cv.notify_all();
+			return true;
+		}
+
+		/// @brief 全ての要求をキャンセルする
+		void CancelAll()
+		{
+			std::vector<Job> canceled_jobs;
+			{
+				std::lock_guard lock(mutex);
+
+				for (auto& [id, is_canceled] : running) { is_canceled = true; }
+				for (auto& queue : queues)
+				{
+					for (auto& job : queue) { canceled_jobs.emplace_back(std::move(job)); }
+					queue.clear();
+				}
+			}
+
+			for (auto& job : canceled_jobs) { job.complete({ LoadStatus::kCanceled, {} }); }
+			idle_cv.notify_all();
+		}
+
+		/// @brief 完了した要求のコールバックを呼び出す
+		/// @brief メインループから毎フレーム呼び出すことを想定している
+		/// @param max_count 1回で呼び出す最大数 (フレーム時間の平滑化に使用)
+		/// @return 呼び出したコールバックの数
+		size_t DispatchCallbacks(const size_t max_count = SIZE_MAX)
+		{
+			std::deque<std::pair<LoadCallback, LoadResult>> dispatching;
+			{
+				std::lock_guard lock(callback_mutex);
+
+				const auto num = std::min(max_count, completed.size());
+				std::move(completed.begin(), completed.begin() + num, std::back_inserter(dispatching));
+				completed.erase(completed.begin(), completed.begin() + num);
+			}
+
+			for (auto& [callback, result] : dispatching)
+			{
+				if (callback) { callback(result); }
+			}
+			return dispatching.size();
+		}
+
+		/// @brief ワーカースレッド数
+		[[nodiscard]] size_t GetThreadNum() const { return workers.size(); }
+
+		/// @brief 待機中・実行中の要求の数
+		[[nodiscard]] size_t GetPendingCount() const
+		{
+			std::lock_guard lock(mutex);
+
+			size_t num = running.size();
+			for (const auto& queue : queues) { num += queue.size(); }
+			return num;
+		}
+
+		/// @brief 待機中・実行中の要求が全て完了するまで待つ
+		void WaitIdle() const
+		{
+			std::unique_lock lock(mutex);
+			idle_cv.wait(lock, [this] { return running.empty() && std::all_of(std::begin(queues), std::end(queues), [](const auto& queue) { return queue.empty(); }); });
+		}
+
+	private:
+		static constexpr size_t kPriorityNum = 3;
+
+		/// @brief 読み込み要求
+		struct Job
+		{
+			RequestId								id = kInvalidRequestId;
+			std::string								file_path;
+			Format									format = Format::kAuto;
+			std::function<void(LoadResult&&)>		complete;
+		};
+
+		/// @brief 要求をキューに追加する
+		RequestId Enqueue(const std::string_view& file_path, std::function<void(LoadResult&&)> complete, const Priority priority, const Format format)
+		{
+			{
+				std::lock_guard lock(mutex);
+
+				size_t queued_num = 0;
+				for (const auto& queue : queues) { queued_num += queue.size(); }
+
+				if (!is_stopped && queued_num < max_queue_size)
+				{
+					const auto id = ++last_id;
+					queues[static_cast<size_t>(priority)].push_back({ id, std::string(file_path), format, std::move(complete) });
+					queue_cv.notify_one();
+					return id;
+				}
+			}
+
+			// 拒否
+			complete({ LoadStatus::kRejected, {} });
+			return kInvalidRequestId;
+		}
+
+		/// @brief 待機中の要求を取り出す (mutexをロックした状態で呼び出す)
+		[[nodiscard]] bool TakeQueued(const RequestId id, Job& out_job)
+		{
+			for (auto& queue : queues)
+			{
+				const auto it = std::find_if(queue.begin(), queue.end(), [id](const Job& job) { return job.id == id; });
+				if (it == queue.end()) { continue; }
+
+				out_job = std::move(*it);
+				queue.erase(it);
+				return true;
+			}
+			return false;
+		}
+
+		/// @brief 優先度の高い順に要求を取り出す (mutexをロックした状態で呼び出す)
+		[[nodiscard]] bool TakeNext(Job& out_job)
+		{
+			for (auto& queue : queues)
+			{
+				if (queue.empty()) { continue; }
+
+				out_job = std::move(queue.front());
+				queue.pop_front();
+				return true;
+			}
+			return false;
+		}
+
+		void WorkerLoop()
+		{
+			while (true)
+			{
+				Job job;
+				{
+					std::unique_lock lock(mutex);
+					queue_cv.wait(lock, [this] { return is_stopped || std::any_of(std::begin(queues), std::end(queues), [](const auto& queue) { return !queue.empty(); }); });
+
+					// 停止後は新しい要求を取り出さない (残りはデストラクタでキャンセルされる)
+					if (is_stopped || !TakeNext(job)) { return; }
+					running.emplace(job.id, false);
+				}
+
+				// 読み込み中の例外(メモリ不足など)はワーカースレッドの外に出さず、失敗として扱う
+				LoadResult result;
+				try
+				{
+					result.status = LoadMapped(job.file_path, result.data, job.format) ? LoadStatus::kSuccess : LoadStatus::kFailed;
+				}
+				catch (...)
+				{
+					result.status = LoadStatus::kFailed;
+					result.data   = nullptr;
+				}
+
+				{
+					std::lock_guard lock(mutex);
+
+					if (running[job.id])
+					{
+						result.status = LoadStatus::kCanceled;
+						result.data   = nullptr;
+					}
+				}
+
+				// 完了を通知してから実行中の要求から外す (WaitIdle後に結果が揃っているようにする)
+				job.complete(std::move(result));
+				{
+					std::lock_guard lock(mutex);
+					running.erase(job.id);
+				}
+				idle_cv.notify_all();
+			}
+		}
+
+		mutable std::mutex						mutex;
+		std::condition_variable					queue_cv;
+		mutable std::condition_variable			idle_cv;
+		std::deque<Job>							queues[kPriorityNum];
+		std::unordered_map<RequestId, bool>		running;		// 実行中の要求とキャンセル済みかどうか
+		RequestId								last_id = kInvalidRequestId;
+		size_t									max_queue_size;
+		bool									is_stopped = false;
+
+		std::mutex												callback_mutex;
+		std::deque<std::pair<LoadCallback, LoadResult>>			completed;
+
+		std::vector<std::thread>				workers;
+	};
+}
@@ -0,0 +1,222 @@
+﻿#pragma once
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <JSON/json_loader.hpp>
+
+namespace json_loader
+{
+	/// @brief 読み込み済みのJSONデータをファイルパスごとに共有するキャッシュ
+	/// @brief 同じファイルを複数の箇所から読み込む場合に、解析を1回で済ませる
+	/// @brief 返すデータは変更不可で、キャッシュから破棄・再読み込みされても参照中のデータは有効なまま
+	class DocumentCache
+	{
+	public:
+		using Document = std::shared_ptr<const nlohmann::json>;
+
+		/// @brief キャッシュの利用状況
+		struct Stats
+		{
+			size_t hit_num				= 0;	// キャッシュから返した回数
+			size_t miss_num				= 0;	// ファイルから読み込んだ回数
+			size_t reload_num			= 0;	// 更新を検出して再読み込みした回数
+			size_t reload_failure_num	= 0;	// 再読み込みに失敗し、以前のデータを返した回数
+		};
+
+		/// @brief JSONデータを取得する
+		/// @brief キャッシュにない場合はファイルから読み込み、ホットリロードが有効な場合は更新日時を確認する
+		/// @brief 同じファイルを複数のスレッドが同時に要求した場合、解析は1回のみ行い、他のスレッドはその完了を待つ
+		/// @brief ホットリロードで再読み込みに失敗した場合 (書き込み途中など) は、成功するまで以前のデータを返し続ける
+		/// @brief 失敗したファイルは、更新日時が再び変わるまで読み込み直さない
+		/// @param format ファイル形式 (kAutoの場合は拡張子から判定。形式ごとに別々にキャッシュする)
+		/// @return JSONデータ (初回の読み込みに失敗した場合はnullptr)
+		[[nodiscard]] Document Get(const std::string_view& file_path, const Format format = Format::kAuto)
+		{
+			const auto file_format = detail::ResolveFormat(file_path, format);
+			const auto key		   = GetKey(file_path, file_format);
+
+			std::unique_lock lock(mutex);
+
+			bool is_reload = false;
+			if (const auto it = entries.find(key); it != entries.end())
+			{
+				// 読み込み中、再読み込み中、または更新されていなければキャッシュを返す
+				if (!IsReady(it->second.document) || it->second.is_reloading || !is_hot_reload || !IsModified(it->second))
+				{
+					++stats.hit_num;
+					const auto document = it->second.document;
+					lock.unlock();
+					return document.get();
+				}
+				is_reload = true;
+			}
+
+			// 読み込み中として登録し、解析中は他のファイルの取得を妨げないようロックを外して読み込む
+			// 再読み込みの場合は成功するまで以前のデータを返し続ける
+			std::promise<Document> promise;
+			auto& entry = entries[key];
+			if (is_reload)
+			{
+				entry.is_reloading = true;
+			}
+			else
+			{
+				entry.file_path = std::filesystem::path(file_path).lexically_normal();
+				entry.document	= promise.get_future().share();
+			}
+			entry.generation = ++last_generation;
+
+			const auto load_path  = entry.file_path;
+			const auto write_time = GetWriteTime(load_path);
+			const auto generation = entry.generation;
+			lock.unlock();
+
+			Document document;
+			try
+			{
+				auto data = std::make_shared<nlohmann::json>();
+				if (LoadMapped(load_path.string(), *data, file_format)) { document = std::move(data); }
+			}
+			catch (...)
+			{
+				document = nullptr;
+			}
+			promise.set_value(document);
+
+			lock.lock();
+			++(is_reload ? stats.reload_num : stats.miss_num);
+
+			// この読み込みの登録が残っている場合のみ反映する (読み込み中に破棄された場合は何もしない)
+			const auto it = entries.find(key);
+			if (it == entries.end() || it->second.generation != generation) { return document; }
+
+			if (is_reload)
+			{
+				it->second.is_reloading = false;
+
+				// 書き込み途中のファイルなどで失敗した場合は、以前のデータと更新日時を保持する
+				// 失敗時の更新日時を記録し、Getのたびに解析し直さず、次にファイルが更新された時点で再読み込みする
+				if (!document)
+				{
+					++stats.reload_failure_num;
+					it->second.failed_write_time = write_time;
+					const auto previous = it->second.document;
+					lock.unlock();
+					return previous.get();
+				}
+				it->second.document = promise.get_future().share();
+			}
+			else if (!document)
+			{
+				// 初回の読み込みに失敗した場合は次のGetで読み込み直せるよう破棄する
+				entries.erase(it);
+				return document;
+			}
+			it->second.write_time		 = write_time;
+			it->second.failed_write_time.reset();
+			return document;
+		}
+
+		/// @brief ホットリロードを有効にする (開発用)
+		/// @brief 有効な間はGetのたびにファイルの更新日時を確認する
+		void SetHotReload(const bool is_enabled)
+		{
+			std::lock_guard lock(mutex);
+			is_hot_reload = is_enabled;
+		}
+
+		/// @brief ファイルのキャッシュを破棄する (全ての形式)
+		void Invalidate(const std::string_view& file_path)
+		{
+			const auto normalized_path = std::filesystem::path(file_path).lexically_normal();
+
+			std::lock_guard lock(mutex);
+			std::erase_if(entries, [&](const auto& key_entry) { return key_entry.second.file_path == normalized_path; });
+		}
+
+		/// @brief 全てのキャッシュを破棄する
+		void Clear()
+		{
+			std::lock_guard lock(mutex);
+			entries.clear();
+		}
+
+		/// @brief キャッシュしているファイル数
+		[[nodiscard]] size_t GetSize() const
+		{
+			std::lock_guard lock(mutex);
+			return entries.size();
+		}
+
+		[[nodiscard]] Stats GetStats() const
+		{
+			std::lock_guard lock(mutex);
+			return stats;
+		}
+
+		void ResetStats()
+		{
+			std::lock_guard lock(mutex);
+			stats = {};
+		}
+
+	private:
+		/// @brief キャッシュしたデータと読み込み時の更新日時
+		struct Entry
+		{
+			std::filesystem::path				file_path;
+			std::shared_future<Document>		document;				// 初回の読み込み中は未完了
+			std::filesystem::file_time_type		write_time;
+			std::optional<std::filesystem::file_time_type>	failed_write_time;	// 最後に再読み込みに失敗した時の更新日時
+			uint64_t							generation		= 0;	// 読み込みごとの通し番号
+			bool								is_reloading	= false;	// 再読み込み中 (documentは以前のデータのまま)
+		};
+
+		/// @brief 表記揺れ("./a.json"と"a.json"など)を同じキーにし、形式ごとに区別する
+		[[nodiscard]] static std::string GetKey(const std::string_view& file_path, const Format format)
+		{
+			return std::filesystem::path(file_path).lexically_normal().string() + "|" + std::to_string(static_cast<int>(format));
+		}
+
+		[[nodiscard]] static bool IsReady(const std::shared_future<Document>& document)
+		{
+			return document.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+
+		/// @brief 更新日時 (取得できない場合は最小値)
+		[[nodiscard]] static std::filesystem::file_time_type GetWriteTime(const std::filesystem::path& file_path)
+		{
+			std::error_code error;
+			const auto write_time = std::filesystem::last_write_time(file_path, error);
+			return error ? std::filesystem::file_time_type::min() : write_time;
+		}
+
+		/// @brief 読み込み後にファイルが更新されたかどうか (更新日時を取得できない場合は更新なしとする)
+		/// @brief 再読み込みに失敗した時から更新日時が変わっていない場合も更新なしとする
+		[[nodiscard]] static bool IsModified(const Entry& entry)
+		{
+			std::error_code error;
+			const auto write_time = std::filesystem::last_write_time(entry.file_path, error);
+			return !error && write_time != entry.write_time && write_time != entry.failed_write_time;
+		}
+
+		mutable std::mutex						mutex;
+		std::unordered_map<std::string, Entry>	entries;
+		Stats									stats;
+		uint64_t								last_generation = 0;
+		bool									is_hot_reload	= false;
+	};
+
+	/// @brief 共有のドキュメントキャッシュを取得する
+	[[nodiscard]] inline DocumentCache& GetDocumentCache()
+	{
+		static DocumentCache cache;
+		return cache;
+	}
+}
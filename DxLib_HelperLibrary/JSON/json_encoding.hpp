@@ -0,0 +1,42 @@
+﻿#pragma once
+
+/// @brief 数学型(VECTOR, Vector2D, MATRIX, Quaternion)のJSON表現の切り替え
+/// @brief 既定はキー付きのオブジェクト({ "x": 1, "y": 2, "z": 3 })で、
+/// @brief 簡易表現を有効にすると配列([1, 2, 3]、MATRIXは16要素の1次元配列)で書き出す
+/// @brief from_jsonはどちらの表現も読み込める
+namespace json_loader
+{
+	namespace detail
+	{
+		[[nodiscard]] inline bool& GetCompactEncodingFlag()
+		{
+			thread_local bool is_compact = false;
+			return is_compact;
+		}
+	}
+
+	/// @brief 簡易表現(配列)で書き出すかどうか (スレッドごとの設定)
+	[[nodiscard]] inline bool IsCompactEncoding() { return detail::GetCompactEncodingFlag(); }
+
+	/// @brief 簡易表現(配列)で書き出すかどうかを設定する (スレッドごとの設定)
+	inline void SetCompactEncoding(const bool is_compact) { detail::GetCompactEncodingFlag() = is_compact; }
+
+	/// @brief スコープ内だけ表現を切り替える
+	class ScopedCompactEncoding
+	{
+	public:
+		explicit ScopedCompactEncoding(const bool is_compact = true) :
+			prev_is_compact(IsCompactEncoding())
+		{
+			SetCompactEncoding(is_compact);
+		}
+
+		~ScopedCompactEncoding() { SetCompactEncoding(prev_is_compact); }
+
+		ScopedCompactEncoding(const ScopedCompactEncoding&)				= delete;
+		ScopedCompactEncoding& operator=(const ScopedCompactEncoding&)	= delete;
+
+	private:
+		bool prev_is_compact;
+	};
+}
@@ -1,20 +1,133 @@
 #pragma once
+#include <atomic>
+#include <cctype>
 #include <string>
 #include <fstream>
+#include <filesystem>
+#include <iomanip>
+#include <vector>
 #include <nlohmann/json.hpp>
 
+#if defined(__has_include)
+	#if __has_include(<sys/mman.h>)
+		#define DXLIB_HELPER_HAS_MMAP 1
+		#include <fcntl.h>
+		#include <sys/mman.h>
+		#include <sys/stat.h>
+		#include <unistd.h>
+	#endif
+#endif
+
+#if defined(_WIN32)
+	#include <io.h>
+	#include <fcntl.h>
+	#include <process.h>
+#elif defined(__has_include)
+	#if __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+		#define DXLIB_HELPER_HAS_FSYNC 1
+		#include <fcntl.h>
+		#include <unistd.h>
+	#endif
+#endif
+
 namespace json_loader
 {
+	/// @brief ۑEǂݍ݂Ɏgpt@C`
+    enum class Format
+    {
+        kAuto,          // gq画肷(sȊgqkText)
+        kText,          // eLXg(JSON)
+        kMessagePack,   // MessagePack (.msgpack, .mpk)
+        kCbor,          // CBOR (.cbor)
+        kBson,          // BSON (.bson) [g̓IuWFNĝ
+        kUbjson,        // UBJSON (.ubj, .ubjson)
+    };
+
+    /// @brief eLXg`̃Cfg (l)
+    inline constexpr int kIndentDefault = 4;
+
+    /// @brief eLXg`sECfgȂŕۑ (oחp)
+    inline constexpr int kIndentCompact = -1;
+
+    namespace detail
+    {
+        /// @brief ݎ̃Xg[obt@TCY
+        inline constexpr size_t kWriteBufferSize = 64 * 1024;
+
+        /// @brief kAutogqۂ̌`ɉ
+        [[nodiscard]] inline Format ResolveFormat(const std::string_view& file_path, const Format format)
+        {
+            if (format != Format::kAuto) { return format; }
+
+            auto extension = std::filesystem::path(file_path).extension().string();
+            for (auto& c : extension) { c = static_cast<char>(std::tolower(static_cast<unsigned char>(c))); }
+
+            if (extension == ".msgpack" || extension == ".mpk") { return Format::kMessagePack; }
+            if (extension == ".cbor")                           { return Format::kCbor; }
+            if (extension == ".bson")                           { return Format::kBson; }
+            if (extension == ".ubj" || extension == ".ubjson")  { return Format::kUbjson; }
+
+            return Format::kText;
+        }
+
+        /// @brief oCi`ǂ
+        [[nodiscard]] inline bool IsBinaryFormat(const Format format)
+        {
+            return format != Format::kAuto && format != Format::kText;
+        }
+
+        /// @brief w`ŃXg[ɏ
+        /// @brief oRXg[֒ڃVACY
+        /// @param indent eLXg`̃Cfg (0ȉ̏ꍇ͉sECfgȂ)
+        inline void Write(std::ostream& os, const nlohmann::json& data, const Format format, const int indent)
+        {
+            switch (format)
+            {
+            case Format::kMessagePack:  nlohmann::json::to_msgpack(data, os);  break;
+            case Format::kCbor:         nlohmann::json::to_cbor(data, os);     break;
+            case Format::kBson:         nlohmann::json::to_bson(data, os);     break;
+            case Format::kUbjson:       nlohmann::json::to_ubjson(data, os);   break;
+            default:                    os << std::setw(indent > 0 ? indent : 0) << data; break;
+            }
+        }
+
+        /// @brief w`œ͂͂
+        /// @param input Xg[A܂̓Ce[^̑g
+        template<typename... Input>
+        [[nodiscard]] inline nlohmann::json Parse(const Format format, Input&&... input)
+        {
+            switch (format)
+            {
+            case Format::kMessagePack:  return nlohmann::json::from_msgpack(std::forward<Input>(input)...);
+            case Format::kCbor:         return nlohmann::json::from_cbor(std::forward<Input>(input)...);
+            case Format::kBson:         return nlohmann::json::from_bson(std::forward<Input>(input)...);
+            case Format::kUbjson:       return nlohmann::json::from_ubjson(std::forward<Input>(input)...);
+            default:                    return nlohmann::json::parse(std::forward<Input>(input)...);
+            }
+        }
+    }
+
 	/// @brief JSONf[^Ot@Cɕۑ
 	/// @brief t@CȂꍇ͎Iɍ쐬
 	/// @param file_path JSONt@CpX
 	/// @param data ۑJSONf[^
+	/// @param format t@C` (kAutȍꍇ͊gq画)
+	/// @param indent eLXg`̃Cfg (kIndentCompact̏ꍇ͉sECfgȂ)
 	/// @return true : ۑ, false : ۑs
-    inline bool Save(const std::string_view& file_path, const nlohmann::json& data)
+    inline bool Save(const std::string_view& file_path, const nlohmann::json& data, const Format format = Format::kAuto, const int indent = kIndentDefault)
     {
+        const auto file_format = detail::ResolveFormat(file_path, format);
+
+        // ݂܂Ƃ߂邽߂̃obt@ (WJOɐݒ肷Kv)
+        std::vector<char> buffer(detail::kWriteBufferSize);
+        std::ofstream ofs;
+        ofs.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
         // ݗpt@C㏑wœWJ
         // t@CȂꍇ쐬
-        std::ofstream ofs(std::string(file_path), std::ios::out);
+        auto mode = std::ios::out;
+        if (detail::IsBinaryFormat(file_format)) { mode |= std::ios::binary; }
+        ofs.open(std::string(file_path), mode);
 
         // WJɎs
         if (!ofs) { return false; }
@@ -22,25 +135,163 @@ namespace json_loader
         try
         {
             // 
-            ofs << data.dump(4);
+            detail::Write(ofs, data, file_format, indent);
+            ofs.close();
         }
         catch (...)
         {
             return false;
         }
 
+        return !ofs.fail();
+    }
+
+    namespace detail
+    {
+        /// @brief t@C̓efBXNɏo
+        /// @return true : , false : s
+        [[nodiscard]] inline bool SyncFile(const std::string& file_path)
+        {
+#if defined(_WIN32)
+            const auto fd = _open(file_path.c_str(), _O_RDWR | _O_BINARY);
+            if (fd < 0) { return false; }
+
+            const auto is_success = _commit(fd) == 0;
+            _close(fd);
+            return is_success;
+#elif defined(DXLIB_HELPER_HAS_FSYNC)
+            const auto fd = open(file_path.c_str(), O_RDWR);
+            if (fd < 0) { return false; }
+
+            const auto is_success = fsync(fd) == 0;
+            close(fd);
+            return is_success;
+#else
+            static_cast<void>(file_path);
+            return true;
+#endif
+        }
+
+        /// @brief fBNg̃GgύX(l[)fBXNɏo
+        /// @brief fBNg𓯊łȂł͉Ȃ
+        inline void SyncDirectory(const std::filesystem::path& directory_path)
+        {
+#if defined(DXLIB_HELPER_HAS_FSYNC) && defined(O_DIRECTORY)
+            const auto fd = open(directory_path.empty() ? "." : directory_path.c_str(), O_RDONLY | O_DIRECTORY);
+            if (fd < 0) { return; }
+
+            fsync(fd);
+            close(fd);
+#else
+            static_cast<void>(directory_path);
+#endif
+        }
+
+        /// @brief ۑƓfBNg̈ꎞt@C̃pX擾 ( : save.json.1234.5.tmp)
+        /// @brief vZXIDƌĂяoƂ̘AԂt邽߁Aۑ֓ɕۑĂꎞt@CdȂȂ
+        [[nodiscard]] inline std::filesystem::path GetTempPath(const std::filesystem::path& file_path)
+        {
+            static std::atomic<unsigned long long> counter = 0;
+
+#if defined(_WIN32)
+            const auto process_id = static_cast<long long>(_getpid());
+#elif defined(DXLIB_HELPER_HAS_FSYNC)
+            const auto process_id = static_cast<long long>(getpid());
+#else
+            const auto process_id = 0LL;
+#endif
+            auto temp_path = file_path;
+            temp_path += "." + std::to_string(process_id) + "." + std::to_string(++counter) + ".tmp";
+            return temp_path;
+        }
+
+        /// @brief obNAbvt@C̃pX擾 ( : save.json.bak1)
+        [[nodiscard]] inline std::filesystem::path GetBackupPath(const std::filesystem::path& file_path, const int generation)
+        {
+            auto backup_path = file_path;
+            backup_path += ".bak" + std::to_string(generation);
+            return backup_path;
+        }
+
+        /// @brief ̃t@CobNAbvƂĐ炵Ȃۑ
+        /// @brief V .bak1, .bak2, ... ƂȂAbackup_count𒴂͔j
+        [[nodiscard]] inline bool RotateBackups(const std::filesystem::path& file_path, const int backup_count)
+        {
+            std::error_code error;
+            if (backup_count <= 0 || !std::filesystem::exists(file_path, error)) { return true; }
+
+            // Âォ珇ɂ炷
+            std::filesystem::remove(GetBackupPath(file_path, backup_count), error);
+            for (int generation = backup_count - 1; generation >= 1; --generation)
+            {
+                const auto backup_path = GetBackupPath(file_path, generation);
+                if (!std::filesystem::exists(backup_path, error)) { continue; }
+
+                std::filesystem::rename(backup_path, GetBackupPath(file_path, generation + 1), error);
+                if (error) { return false; }
+            }
+
+            // ۑ͒u܂ŎcĂ߁Aړł͂Ȃ
+            std::filesystem::copy_file(file_path, GetBackupPath(file_path, 1), std::filesystem::copy_options::overwrite_existing, error);
+            return !error;
+        }
+    }
+
+	/// @brief JSONf[^Ot@CɈSɕۑ
+	/// @brief fBNg̈ꎞt@Cɏ݁AfBXN֏oɃl[Œu邽߁A
+	/// @brief ݒɃNbVEeʕsĂۑ悪ꂽԂɂȂȂ
+	/// @param file_path JSONt@CpX
+	/// @param data ۑJSONf[^
+	/// @param format t@C` (kAutȍꍇ͕ۑ̊gq画)
+	/// @param indent eLXg`̃Cfg (kIndentCompact̏ꍇ͉sECfgȂ)
+	/// @param backup_count uÕt@Cc㐔 (0̏ꍇ͎cȂ)
+	/// @return true : ۑ, false : ۑs (ۑ͕ύXȂ)
+    inline bool SaveAtomic(const std::string_view& file_path, const nlohmann::json& data, const Format format = Format::kAuto, const int indent = kIndentDefault, const int backup_count = 0)
+    {
+        const std::filesystem::path path(file_path);
+        const auto temp_path = detail::GetTempPath(path);
+
+        std::error_code error;
+
+        // ꎞt@Cɏ݁AfBXNɏo
+        // `͈ꎞt@Cł͂Ȃۑ̊gq画肷
+        if (!Save(temp_path.string(), data, detail::ResolveFormat(file_path, format), indent) || !detail::SyncFile(temp_path.string()))
+        {
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+
+        // uOɃobNAbv쐬
+        if (!detail::RotateBackups(path, backup_count))
+        {
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+
+        // ۑu
+        std::filesystem::rename(temp_path, path, error);
+        if (error)
+        {
+            std::filesystem::remove(temp_path, error);
+            return false;
+        }
+
+        detail::SyncDirectory(path.parent_path());
         return true;
     }
 
 	/// @brief Ot@CJSONf[^ǂݍ
 	/// @param file_path JSONt@CpX
 	/// @param data ǂݍJSONf[^
+	/// @param format t@C` (kAutȍꍇ͊gq画)
 	/// @return true : ǂݍݐ, false : ǂݍݎs
-    [[nodiscard]] inline bool Load(const std::string_view& file_path, nlohmann::json& data)
+    [[nodiscard]] inline bool Load(const std::string_view& file_path, nlohmann::json& data, const Format format = Format::kAuto)
     {
+        const auto file_format = detail::ResolveFormat(file_path, format);
+
         // ǂݍݗpt@CWJ
         std::string path = std::string(file_path);
-        std::ifstream ifs(path);
+        std::ifstream ifs(path, detail::IsBinaryFormat(file_format) ? std::ios::in | std::ios::binary : std::ios::in);
 
         // WJɎs
         if (!ifs) return false;
@@ -48,7 +299,132 @@ namespace json_loader
         try
         {
             // ǂݍ
-            ifs >> data;
+            data = detail::Parse(file_format, ifs);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    namespace detail
+    {
+        /// @brief ǂݍݐpŃɓWJt@C
+        /// @brief POSIXłmmapŃ}bvAȊO̊ł͈x̓ǂݍ݂Ńobt@ɓWJ
+        /// @brief ʏ̃t@CłȂꍇ(fBNgȂ)WJɎsꍇ͗O𓊂ɖƂȂ
+        class MappedFile
+        {
+        public:
+            explicit MappedFile(const std::string& file_path) noexcept
+            {
+                try
+                {
+                    Open(file_path);
+                }
+                catch (...)
+                {
+                    is_valid = false;
+                }
+            }
+
+            ~MappedFile()
+            {
+#if defined(DXLIB_HELPER_HAS_MMAP)
+                if (is_mapped) { munmap(const_cast<char*>(data), size); }
+#endif
+            }
+
+            MappedFile(const MappedFile&)            = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            [[nodiscard]] bool        IsValid() const { return is_valid; }
+            [[nodiscard]] const char* GetData() const { return data; }
+            [[nodiscard]] size_t      GetSize() const { return size; }
+
+        private:
+            void Open(const std::string& file_path)
+            {
+                std::error_code error;
+                if (!std::filesystem::is_regular_file(file_path, error)) { return; }
+
+#if defined(DXLIB_HELPER_HAS_MMAP)
+                const auto fd = open(file_path.c_str(), O_RDONLY);
+                if (fd < 0) { return; }
+
+                struct stat file_stat {};
+                if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode))
+                {
+                    size = static_cast<size_t>(file_stat.st_size);
+
+                    // t@C̓}bvłȂ߁Ãf[^ƂĈ
+                    if (size == 0)
+                    {
+                        is_valid = true;
+                    }
+                    else
+                    {
+                        const auto mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                        if (mapped != MAP_FAILED)
+                        {
+                            madvise(mapped, size, MADV_SEQUENTIAL);
+                            data      = static_cast<const char*>(mapped);
+                            is_mapped = true;
+                            is_valid  = true;
+                        }
+                    }
+                }
+
+                // }bv̓t@CfBXNv^sv
+                close(fd);
+                if (is_valid) { return; }
+#endif
+                // x̓ǂݍ݂Ńobt@ɓWJ
+                std::ifstream ifs(file_path, std::ios::binary | std::ios::ate);
+                if (!ifs) { return; }
+
+                const auto file_size = ifs.tellg();
+                if (file_size < 0) { return; }
+
+                buffer.resize(static_cast<size_t>(file_size));
+                ifs.seekg(0);
+                if (!ifs.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) { return; }
+
+                data     = buffer.data();
+                size     = buffer.size();
+                is_valid = true;
+            }
+
+            const char* data      = nullptr;
+            size_t      size      = 0;
+            bool        is_mapped = false;
+            bool        is_valid  = false;
+            std::string buffer;
+        };
+    }
+
+	/// @brief Ot@C}bvJSONf[^ǂݍ
+	/// @brief Xg[1ǂLoadƈقȂAA𒼐ډ͂邽ߑ傫ȃt@Cō
+	/// @param file_path JSONt@CpX
+	/// @param data ǂݍJSONf[^
+	/// @param format t@C` (kAutȍꍇ͊gq画)
+	/// @return true : ǂݍݐ, false : ǂݍݎs
+    [[nodiscard]] inline bool LoadMapped(const std::string_view& file_path, nlohmann::json& data, const Format format = Format::kAuto)
+    {
+        const auto file_format = detail::ResolveFormat(file_path, format);
+
+        try
+        {
+            // ǂݍݗpt@CWJ
+            const detail::MappedFile file((std::string(file_path)));
+
+            // WJɎs
+            if (!file.IsValid()) { return false; }
+
+            // ǂݍ
+            const auto begin = reinterpret_cast<const std::uint8_t*>(file.GetData());
+            data = detail::Parse(file_format, begin, begin + file.GetSize());
         }
         catch (...)
         {
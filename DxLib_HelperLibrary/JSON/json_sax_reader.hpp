@@ -0,0 +1,355 @@
+﻿#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <JSON/json_loader.hpp>
+#include <Vector/vector_2d.hpp>
+#include <Vector/vector_3d.hpp>
+#include <Matrix/matrix.hpp>
+#include <Axis/axis.hpp>
+
+/// @brief JSONをDOM(nlohmann::json)を構築せずに型へ直接読み込むSAXリーダー
+/// @brief from_jsonと同じ形式に対応し、大量の座標・行列データの読み込みでメモリ確保を抑える
+namespace json_loader
+{
+	namespace sax
+	{
+		/// @brief 読み込み中のコンテナ(オブジェクト・配列)と現在位置
+		struct Frame
+		{
+			bool		is_array = false;
+			size_t		index	 = 0;	// 配列の場合の要素番号
+			std::string	key;			// オブジェクトの場合のキー
+		};
+
+		/// @brief 型ごとの読み込み方法
+		/// @brief kSlotNum : 数値の数
+		/// @brief GetSlot : 要素内のパスから数値の格納先番号を求める (対象外の場合は-1)
+		/// @brief Build : 全ての数値が揃った後に型を構築する
+		template<typename T>
+		struct Traits;
+
+		/// @brief { "x", "y", "z" } または [x, y, z]
+		template<>
+		struct Traits<VECTOR>
+		{
+			static constexpr int kSlotNum = 3;
+
+			[[nodiscard]] static int GetSlot(const Frame* path, const size_t depth)
+			{
+				if (depth != 1)		  { return -1; }
+				if (path[0].is_array) { return path[0].index < static_cast<size_t>(kSlotNum) ? static_cast<int>(path[0].index) : -1; }
+
+				const auto& key = path[0].key;
+				if (key == "x") { return 0; }
+				if (key == "y") { return 1; }
+				if (key == "z") { return 2; }
+				return -1;
+			}
+
+			[[nodiscard]] static VECTOR Build(const double* slots)
+			{
+				return { static_cast<float>(slots[0]), static_cast<float>(slots[1]), static_cast<float>(slots[2]) };
+			}
+		};
+
+		/// @brief { "x", "y" } または [x, y]
+		template<typename ElemT>
+		struct Traits<Vector2D<ElemT>>
+		{
+			static constexpr int kSlotNum = 2;
+
+			[[nodiscard]] static int GetSlot(const Frame* path, const size_t depth)
+			{
+				if (depth != 1)		  { return -1; }
+				if (path[0].is_array) { return path[0].index < static_cast<size_t>(kSlotNum) ? static_cast<int>(path[0].index) : -1; }
+
+				const auto& key = path[0].key;
+				if (key == "x") { return 0; }
+				if (key == "y") { return 1; }
+				return -1;
+			}
+
+			[[nodiscard]] static Vector2D<ElemT> Build(const double* slots)
+			{
+				return { static_cast<ElemT>(slots[0]), static_cast<ElemT>(slots[1]) };
+			}
+		};
+
+		/// @brief [[4], [4], [4], [4]] または16要素の1次元配列
+		template<>
+		struct Traits<MATRIX>
+		{
+			static constexpr int kSlotNum = 16;
+
+			[[nodiscard]] static int GetSlot(const Frame* path, const size_t depth)
+			{
+				// 1次元配列
+				if (depth == 1 && path[0].is_array) { return path[0].index < static_cast<size_t>(kSlotNum) ? static_cast<int>(path[0].index) : -1; }
+
+				if (depth != 2 || !path[0].is_array || !path[1].is_array)	{ return -1; }
+				if (path[0].index >= 4 || path[1].index >= 4)				{ return -1; }
+
+				return static_cast<int>(path[0].index * 4 + path[1].index);
+			}
+
+			[[nodiscard]] static MATRIX Build(const double* slots)
+			{
+				MATRIX mat{};
+				for (int i = 0; i < kSlotNum; ++i) { mat.m[i / 4][i % 4] = static_cast<float>(slots[i]); }
+				return mat;
+			}
+		};
+
+		/// @brief { "x_axis", "y_axis", "z_axis" } (各軸はVECTORのどちらの表現でもよい)
+		template<>
+		struct Traits<Axis>
+		{
+			static constexpr int kSlotNum = 9;
+
+			[[nodiscard]] static int GetSlot(const Frame* path, const size_t depth)
+			{
+				if (depth != 2 || path[0].is_array) { return -1; }
+
+				const auto& key = path[0].key;
+				int axis_index = -1;
+				if		(key == "x_axis") { axis_index = 0; }
+				else if (key == "y_axis") { axis_index = 1; }
+				else if (key == "z_axis") { axis_index = 2; }
+				else					  { return -1; }
+
+				const auto component = Traits<VECTOR>::GetSlot(path + 1, 1);
+				return component < 0 ? -1 : axis_index * 3 + component;
+			}
+
+			[[nodiscard]] static Axis Build(const double* slots)
+			{
+				return { Traits<VECTOR>::Build(slots), Traits<VECTOR>::Build(slots + 3), Traits<VECTOR>::Build(slots + 6) };
+			}
+		};
+
+		/// @brief 型Tの値、または配列を読み込むSAXハンドラー
+		/// @brief 対象外のキーは読み飛ばし、必要な値が欠けている・数値でない場合は失敗する
+		template<typename T>
+		class Handler : public nlohmann::json::json_sax_t
+		{
+		public:
+			using Traits = sax::Traits<T>;
+			static_assert(Traits::kSlotNum <= 32, "slot mask is 32 bits");
+
+			/// @param out 読み込んだ値の出力先
+			/// @param is_array 配列として読み込むかどうか
+			/// @param member_key ルートオブジェクトのメンバーから読み込む場合のキー (空の場合はルート)
+			Handler(std::vector<T>& out, const bool is_array, const std::string_view& member_key) :
+				out(out),
+				is_array(is_array),
+				member_key(member_key),
+				target_depth(member_key.empty() ? 0 : 1),
+				element_depth(target_depth + (is_array ? 1 : 0))
+			{
+			}
+
+			/// @brief 対象の値を読み込めたかどうか
+			[[nodiscard]] bool IsCompleted() const { return is_completed; }
+
+			bool null()									override { return OnValue(false, 0.0); }
+			bool boolean(bool val)						override { return OnValue(true, val ? 1.0 : 0.0); }
+			bool number_integer(number_integer_t val)	override { return OnValue(true, static_cast<double>(val)); }
+			bool number_unsigned(number_unsigned_t val)	override { return OnValue(true, static_cast<double>(val)); }
+			bool number_float(number_float_t val, const string_t&) override { return OnValue(true, static_cast<double>(val)); }
+			bool string(string_t&)						override { return OnValue(false, 0.0); }
+			bool binary(binary_t&)						override { return OnValue(false, 0.0); }
+
+			bool start_object(std::size_t) override { return OnStartContainer(false); }
+			bool start_array (std::size_t) override { return OnStartContainer(true); }
+			bool end_object() override { return OnEndContainer(); }
+			bool end_array () override { return OnEndContainer(); }
+
+			bool key(string_t& val) override
+			{
+				stack.back().key = val;
+				return true;
+			}
+
+			bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override
+			{
+				return false;
+			}
+
+		private:
+			/// @brief 現在の位置が対象の値(または配列)の中にあるかどうか
+			[[nodiscard]] bool IsInTarget() const
+			{
+				if (stack.size() < element_depth) { return false; }
+
+				// ルートオブジェクトの指定メンバー
+				if (target_depth == 1 && (stack[0].is_array || stack[0].key != member_key)) { return false; }
+
+				return true;
+			}
+
+			/// @brief 値の位置に応じて格納する
+			/// @param is_number 数値として扱える値かどうか
+			bool OnValue(const bool is_number, const double val)
+			{
+				const auto depth = stack.size();
+
+				// 対象の値そのものが数値などの場合 (配列の場合は要素)
+				if (depth == element_depth && IsInTarget()) { return false; }
+
+				if (depth > element_depth && IsInTarget())
+				{
+					const auto slot = Traits::GetSlot(stack.data() + element_depth, depth - element_depth);
+					if (slot >= 0)
+					{
+						if (!is_number) { return false; }
+
+						slots[slot] = val;
+						filled_mask |= std::uint32_t(1) << slot;
+					}
+				}
+
+				AdvanceIndex();
+				return true;
+			}
+
+			bool OnStartContainer(const bool is_array_container)
+			{
+				const auto depth = stack.size();
+
+				// 対象の値の開始
+				if (depth == target_depth && IsTargetPosition())
+				{
+					if (is_array && !is_array_container) { return false; }
+					if (!is_array) { BeginElement(); }
+				}
+				else if (is_array && depth == element_depth && IsInTarget())
+				{
+					BeginElement();
+				}
+
+				stack.push_back({ is_array_container, 0, {} });
+				return true;
+			}
+
+			bool OnEndContainer()
+			{
+				stack.pop_back();
+				const auto depth = stack.size();
+
+				// 要素の終了
+				if (depth == element_depth && IsInTarget())
+				{
+					if (filled_mask != kFullMask) { return false; }
+					out.emplace_back(Traits::Build(slots));
+				}
+
+				// 対象の値の終了
+				if (depth == target_depth && IsTargetPosition()) { is_completed = true; }
+
+				AdvanceIndex();
+				return true;
+			}
+
+			/// @brief 対象の値の位置かどうか (ルート、またはルートオブジェクトの指定メンバー)
+			[[nodiscard]] bool IsTargetPosition() const
+			{
+				if (target_depth == 0) { return true; }
+				return stack.size() == 1 && !stack[0].is_array && stack[0].key == member_key;
+			}
+
+			void BeginElement()
+			{
+				filled_mask = 0;
+			}
+
+			/// @brief 値を1つ読み終えたら配列の要素番号を進める
+			void AdvanceIndex()
+			{
+				if (!stack.empty() && stack.back().is_array) { ++stack.back().index; }
+			}
+
+			static constexpr std::uint32_t kFullMask = Traits::kSlotNum == 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << Traits::kSlotNum) - 1;
+
+			std::vector<T>&		out;
+			bool				is_array;
+			std::string			member_key;
+			size_t				target_depth;
+			size_t				element_depth;
+
+			std::vector<Frame>	stack;
+			double				slots[Traits::kSlotNum] = {};
+			std::uint32_t		filled_mask	 = 0;
+			bool				is_completed = false;
+		};
+
+		/// @brief 形式をnlohmannの入力形式に変換する
+		[[nodiscard]] inline nlohmann::json::input_format_t ToInputFormat(const Format format)
+		{
+			switch (format)
+			{
+			case Format::kMessagePack:	return nlohmann::json::input_format_t::msgpack;
+			case Format::kCbor:			return nlohmann::json::input_format_t::cbor;
+			case Format::kBson:			return nlohmann::json::input_format_t::bson;
+			case Format::kUbjson:		return nlohmann::json::input_format_t::ubjson;
+			default:					return nlohmann::json::input_format_t::json;
+			}
+		}
+
+		/// @brief ファイルをSAXで読み込む
+		template<typename T>
+		[[nodiscard]] inline bool Load(const std::string_view& file_path, std::vector<T>& out, const bool is_array, const std::string_view& member_key, const Format format)
+		{
+			try
+			{
+				const detail::MappedFile file((std::string(file_path)));
+				if (!file.IsValid()) { return false; }
+
+				Handler<T> handler(out, is_array, member_key);
+				const auto begin = reinterpret_cast<const std::uint8_t*>(file.GetData());
+				if (!nlohmann::json::sax_parse(begin, begin + file.GetSize(), &handler, ToInputFormat(detail::ResolveFormat(file_path, format)))) { return false; }
+
+				return handler.IsCompleted();
+			}
+			catch (...)
+			{
+				return false;
+			}
+		}
+	}
+
+	/// @brief 外部ファイルから値を直接読み込む
+	/// @brief 対応する型 : VECTOR, MATRIX, Axis, Vector2D
+	/// @param file_path JSONファイルパス
+	/// @param data 読み込んだ値
+	/// @param member_key ルートオブジェクトのメンバーから読み込む場合のキー (空の場合はルート)
+	/// @param format ファイル形式 (kAutoの場合は拡張子から判定)
+	/// @return true : 読み込み成功, false : 読み込み失敗
+	template<typename T>
+	[[nodiscard]] inline bool LoadTyped(const std::string_view& file_path, T& data, const std::string_view& member_key = {}, const Format format = Format::kAuto)
+	{
+		std::vector<T> values;
+		if (!sax::Load(file_path, values, false, member_key, format) || values.size() != 1) { return false; }
+
+		data = values.front();
+		return true;
+	}
+
+	/// @brief 外部ファイルから値の配列を直接読み込む
+	/// @brief 対応する型 : VECTOR, MATRIX, Axis, Vector2D
+	/// @param file_path JSONファイルパス
+	/// @param data 読み込んだ配列 (既存の要素は破棄される)
+	/// @param member_key ルートオブジェクトのメンバーから読み込む場合のキー (空の場合はルート)
+	/// @param format ファイル形式 (kAutoの場合は拡張子から判定)
+	/// @return true : 読み込み成功, false : 読み込み失敗
+	template<typename T>
+	[[nodiscard]] inline bool LoadTypedArray(const std::string_view& file_path, std::vector<T>& data, const std::string_view& member_key = {}, const Format format = Format::kAuto)
+	{
+		data.clear();
+		if (sax::Load(file_path, data, true, member_key, format)) { return true; }
+
+		data.clear();
+		return false;
+	}
+}
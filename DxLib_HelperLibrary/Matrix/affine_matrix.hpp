@@ -0,0 +1,233 @@
+﻿#pragma once
+#include <Matrix/matrix.hpp>
+
+/// @brief アフィン変換行列 (3x4, 48バイト)
+/// @brief MATRIXを転置し、射影成分(4列目)を省いた形で保持する
+/// @brief m[i][0..2] : MATRIXのi列目の回転・スケール成分, m[i][3] : MATRIXの座標成分
+struct AffineMatrix
+{
+	float m[3][4];
+};
+
+namespace matrix
+{
+	/// @brief 単位行列を取得
+	[[nodiscard]] inline AffineMatrix GetAffineIdent()
+	{
+		return { {
+			{ 1.0f, 0.0f, 0.0f, 0.0f },
+			{ 0.0f, 1.0f, 0.0f, 0.0f },
+			{ 0.0f, 0.0f, 1.0f, 0.0f }
+		} };
+	}
+
+	/// @brief MATRIXをアフィン変換行列に変換 (射影成分は破棄される)
+	[[nodiscard]] inline AffineMatrix ToAffine(const MATRIX& mat)
+	{
+		AffineMatrix affine;
+		for (int i = 0; i < 3; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				affine.m[i][j] = mat.m[j][i];
+			}
+		}
+		return affine;
+	}
+
+	/// @brief アフィン変換行列をMATRIXに変換
+	[[nodiscard]] inline MATRIX ToMatrix(const AffineMatrix& affine)
+	{
+		MATRIX mat;
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				mat.m[i][j] = affine.m[j][i];
+			}
+		}
+		mat.m[0][3] = 0.0f;
+		mat.m[1][3] = 0.0f;
+		mat.m[2][3] = 0.0f;
+		mat.m[3][3] = 1.0f;
+		return mat;
+	}
+
+	/// @brief アフィン変換行列の積(mat1 * mat2)を求める
+	/// @brief MATRIXと同じくmat1の変換の後にmat2の変換を行う。射影成分の計算を省く
+	[[nodiscard]] inline AffineMatrix Multiply(const AffineMatrix& mat1, const AffineMatrix& mat2)
+	{
+		AffineMatrix result;
+
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+		// 転置して保持しているため mat2 * mat1 の順に計算する
+		const auto row0 = _mm_loadu_ps(mat1.m[0]);
+		const auto row1 = _mm_loadu_ps(mat1.m[1]);
+		const auto row2 = _mm_loadu_ps(mat1.m[2]);
+		const auto mask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+		for (int i = 0; i < 3; ++i)
+		{
+			const auto lhs = _mm_loadu_ps(mat2.m[i]);
+
+			auto sum = _mm_and_ps(lhs, mask);
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(0, 0, 0, 0)), row0));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(1, 1, 1, 1)), row1));
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 2, 2, 2)), row2));
+
+			_mm_storeu_ps(result.m[i], sum);
+		}
+#else
+		// 転置して保持しているため mat2 * mat1 の順に計算する
+		for (int i = 0; i < 3; ++i)
+		{
+			for (int j = 0; j < 4; ++j)
+			{
+				result.m[i][j] = mat2.m[i][0] * mat1.m[0][j]
+							   + mat2.m[i][1] * mat1.m[1][j]
+							   + mat2.m[i][2] * mat1.m[2][j];
+			}
+			result.m[i][3] += mat2.m[i][3];
+		}
+#endif
+
+		return result;
+	}
+
+	/// @brief アフィン変換行列の逆行列を求める
+	/// @brief 逆行列が存在しない場合は単位行列を返す
+	[[nodiscard]] inline AffineMatrix Inverse(const AffineMatrix& mat)
+	{
+		const auto& m = mat.m;
+
+		// 3x3部分の余因子
+		const auto c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+		const auto c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+		const auto c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+
+		const auto det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+		if (det == 0.0f) { return GetAffineIdent(); }
+
+		const auto inv_det = 1.0f / det;
+
+		AffineMatrix result;
+		result.m[0][0] = c00 * inv_det;
+		result.m[1][0] = c01 * inv_det;
+		result.m[2][0] = c02 * inv_det;
+		result.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv_det;
+		result.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv_det;
+		result.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv_det;
+		result.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv_det;
+		result.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv_det;
+		result.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv_det;
+
+		// 座標成分は逆回転・逆スケールを掛けて反転する
+		for (int i = 0; i < 3; ++i)
+		{
+			result.m[i][3] = -(result.m[i][0] * m[0][3] + result.m[i][1] * m[1][3] + result.m[i][2] * m[2][3]);
+		}
+
+		return result;
+	}
+
+	/// @brief 回転と平行移動のみからなるアフィン変換行列の逆行列を求める
+	/// @brief 回転成分の転置で求めるため、スケールを含む行列には使用できない
+	[[nodiscard]] inline AffineMatrix InverseRigid(const AffineMatrix& mat)
+	{
+		const auto& m = mat.m;
+
+		AffineMatrix result;
+		for (int i = 0; i < 3; ++i)
+		{
+			result.m[i][0] = m[0][i];
+			result.m[i][1] = m[1][i];
+			result.m[i][2] = m[2][i];
+			result.m[i][3] = -(m[0][i] * m[0][3] + m[1][i] * m[1][3] + m[2][i] * m[2][3]);
+		}
+		return result;
+	}
+
+	/// @brief 座標を変換する
+	[[nodiscard]] inline VECTOR Transform(const AffineMatrix& mat, const VECTOR& pos)
+	{
+		const auto& m = mat.m;
+		return {
+			m[0][0] * pos.x + m[0][1] * pos.y + m[0][2] * pos.z + m[0][3],
+			m[1][0] * pos.x + m[1][1] * pos.y + m[1][2] * pos.z + m[1][3],
+			m[2][0] * pos.x + m[2][1] * pos.y + m[2][2] * pos.z + m[2][3]
+		};
+	}
+
+	/// @brief 方向ベクトルを変換する (座標成分は無視される)
+	[[nodiscard]] inline VECTOR TransformDir(const AffineMatrix& mat, const VECTOR& dir)
+	{
+		const auto& m = mat.m;
+		return {
+			m[0][0] * dir.x + m[0][1] * dir.y + m[0][2] * dir.z,
+			m[1][0] * dir.x + m[1][1] * dir.y + m[1][2] * dir.z,
+			m[2][0] * dir.x + m[2][1] * dir.y + m[2][2] * dir.z
+		};
+	}
+
+	/// @brief 行列の座標成分を取得
+	[[nodiscard]] inline VECTOR GetPos(const AffineMatrix& mat)
+	{
+		return { mat.m[0][3], mat.m[1][3], mat.m[2][3] };
+	}
+
+	/// @brief 行列に座標成分を設定
+	inline void SetPos(AffineMatrix& mat, const VECTOR& pos)
+	{
+		mat.m[0][3] = pos.x;
+		mat.m[1][3] = pos.y;
+		mat.m[2][3] = pos.z;
+	}
+}
+
+inline AffineMatrix operator* (const AffineMatrix& mat1, const AffineMatrix& mat2)	{ return matrix::Multiply(mat1, mat2); }
+inline AffineMatrix operator*=(AffineMatrix& mat1, const AffineMatrix& mat2)		{ mat1 = mat1 * mat2; return mat1; }
+
+inline bool operator==(const AffineMatrix& mat1, const AffineMatrix& mat2)
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		for (int j = 0; j < 4; ++j)
+		{
+			if (mat1.m[i][j] != mat2.m[i][j])
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+inline bool operator!=(const AffineMatrix& mat1, const AffineMatrix& mat2) { return !(mat1 == mat2); }
+
+
+#pragma region from / to JSON
+inline void from_json(const nlohmann::json& data, AffineMatrix& mat)
+{
+	auto m = data.get<std::array<std::array<float, 4>, 3>>();
+	for (int i = 0; i < 3; ++i)
+	{
+		for (int j = 0; j < 4; ++j)
+		{
+			mat.m[i][j] = m[i][j];
+		}
+	}
+}
+
+inline void to_json(nlohmann::json& data, const AffineMatrix& mat)
+{
+	std::array<std::array<float, 4>, 3> m{};
+	for (int i = 0; i < 3; ++i)
+	{
+		for (int j = 0; j < 4; ++j)
+		{
+			m[i][j] = mat.m[i][j];
+		}
+	}
+
+	data = m;
+}
+#pragma endregion
@@ -1,20 +1,232 @@
 ﻿#pragma once
+#include <cmath>
+#include <type_traits>
 #include <nlohmann/json.hpp>
+#include <JSON/json_encoding.hpp>
+#if defined(DXLIB_HELPER_HEADLESS)
+#include <Headless/dxlib_headless.hpp>
+#else
 #include <DxLib.h>
+#endif
+#include <SIMD/simd.hpp>
 
-inline MATRIX operator+ (const MATRIX& mat1, const MATRIX& mat2)	{ return MAdd (mat1, mat2); }
-inline MATRIX operator* (const MATRIX& mat1, const MATRIX& mat2)	{ return MMult(mat1, mat2); }
+namespace matrix
+{
+	namespace detail
+	{
+		/// @brief 右辺行列の各行をレジスタに展開したもの
+		/// @brief 同じ右辺を複数回掛ける場合に読み込みを一度で済ませる
+		struct MultiplyRhs
+		{
+#if defined(DXLIB_HELPER_SIMD_AVX)
+			__m256 rows[4];		// 各行を上下128bitに複製
+#elif defined(DXLIB_HELPER_SIMD_SSE2)
+			__m128 rows[4];
+#else
+			MATRIX mat;
+#endif
+		};
+
+		[[nodiscard]] inline MultiplyRhs LoadMultiplyRhs(const MATRIX& mat)
+		{
+			MultiplyRhs rhs;
+#if defined(DXLIB_HELPER_SIMD_AVX)
+			for (int i = 0; i < 4; ++i) { rhs.rows[i] = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(mat.m[i])); }
+#elif defined(DXLIB_HELPER_SIMD_SSE2)
+			for (int i = 0; i < 4; ++i) { rhs.rows[i] = _mm_loadu_ps(mat.m[i]); }
+#else
+			rhs.mat = mat;
+#endif
+			return rhs;
+		}
+
+		/// @brief out = lhs * rhs
+		/// @brief outはlhsと同じ行列でもよい
+		inline void MultiplyRows(const MATRIX& lhs, const MultiplyRhs& rhs, MATRIX& out)
+		{
+#if defined(DXLIB_HELPER_SIMD_AVX)
+			// lhsの2行分を同時に計算する
+			for (int i = 0; i < 4; i += 2)
+			{
+				const auto row = _mm256_loadu_ps(lhs.m[i]);
 
-inline MATRIX operator* (const MATRIX& mat, const float scale)		{ return MScale(mat, scale); }
-inline MATRIX operator* (const float scale, const MATRIX& mat)		{ return MScale(mat, scale); }
+				auto sum = _mm256_mul_ps(_mm256_permute_ps(row, _MM_SHUFFLE(0, 0, 0, 0)), rhs.rows[0]);
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(row, _MM_SHUFFLE(1, 1, 1, 1)), rhs.rows[1]));
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(row, _MM_SHUFFLE(2, 2, 2, 2)), rhs.rows[2]));
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_permute_ps(row, _MM_SHUFFLE(3, 3, 3, 3)), rhs.rows[3]));
+
+				_mm256_storeu_ps(out.m[i], sum);
+			}
+#elif defined(DXLIB_HELPER_SIMD_SSE2)
+			for (int i = 0; i < 4; ++i)
+			{
+				const auto row = _mm_loadu_ps(lhs.m[i]);
 
-inline MATRIX operator+=(MATRIX& mat1, const MATRIX& mat2)			{ mat1 = mat1 + mat2; return mat1; }
-inline MATRIX operator*=(MATRIX& mat1, const MATRIX& mat2)			{ mat1 = mat1 * mat2; return mat1; }
+				auto sum = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), rhs.rows[0]);
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), rhs.rows[1]));
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), rhs.rows[2]));
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), rhs.rows[3]));
+
+				_mm_storeu_ps(out.m[i], sum);
+			}
+#else
+			MATRIX result;
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+				{
+					result.m[i][j] = lhs.m[i][0] * rhs.mat.m[0][j]
+								   + lhs.m[i][1] * rhs.mat.m[1][j]
+								   + lhs.m[i][2] * rhs.mat.m[2][j]
+								   + lhs.m[i][3] * rhs.mat.m[3][j];
+				}
+			}
+			out = result;
+#endif
+		}
+
+		/// @brief lhs * rhs をスカラー演算で求める (コンパイル時評価用)
+		[[nodiscard]] constexpr MATRIX MultiplyScalar(const MATRIX& lhs, const MATRIX& rhs)
+		{
+			MATRIX result{};
+			for (int i = 0; i < 4; ++i)
+			{
+				for (int j = 0; j < 4; ++j)
+				{
+					result.m[i][j] = lhs.m[i][0] * rhs.m[0][j]
+								   + lhs.m[i][1] * rhs.m[1][j]
+								   + lhs.m[i][2] * rhs.m[2][j]
+								   + lhs.m[i][3] * rhs.m[3][j];
+				}
+			}
+			return result;
+		}
+	}
+
+	/// @brief 行列の積(mat1 * mat2)を求める
+	/// @brief MMultと同じ結果を、インライン展開可能なSIMD実装(AVX / SSE2 / スカラー)で求める
+	/// @brief コンパイル時に評価される場合はスカラー演算で求める
+	[[nodiscard]] constexpr MATRIX Multiply(const MATRIX& mat1, const MATRIX& mat2)
+	{
+		if (std::is_constant_evaluated()) { return detail::MultiplyScalar(mat1, mat2); }
+
+		MATRIX result;
+		detail::MultiplyRows(mat1, detail::LoadMultiplyRhs(mat2), result);
+		return result;
+	}
+
+	/// @brief 行列配列の積を一括で求める (out[i] = mat1[i] * mat2[i])
+	/// @brief outはmat1と同じ配列でもよい
+	/// @param num 行列の数
+	inline void MultiplyArray(const MATRIX* mat1, const MATRIX* mat2, MATRIX* out, const size_t num)
+	{
+		for (size_t i = 0; i < num; ++i)
+		{
+			detail::MultiplyRows(mat1[i], detail::LoadMultiplyRhs(mat2[i]), out[i]);
+		}
+	}
+
+	/// @brief 行列配列の全要素に同じ行列を右から掛ける (out[i] = mat1[i] * mat2)
+	/// @brief mat2の読み込みは一度のみ行う。outはmat1と同じ配列でもよい
+	/// @param num 行列の数
+	inline void MultiplyArray(const MATRIX* mat1, const MATRIX& mat2, MATRIX* out, const size_t num)
+	{
+		const auto rhs = detail::LoadMultiplyRhs(mat2);
+		for (size_t i = 0; i < num; ++i)
+		{
+			detail::MultiplyRows(mat1[i], rhs, out[i]);
+		}
+	}
+
+	/// @brief 行列配列の全要素に同じ行列を左から掛ける (out[i] = mat1 * mat2[i])
+	/// @param num 行列の数
+	inline void MultiplyArray(const MATRIX& mat1, const MATRIX* mat2, MATRIX* out, const size_t num)
+	{
+		for (size_t i = 0; i < num; ++i)
+		{
+			detail::MultiplyRows(mat1, detail::LoadMultiplyRhs(mat2[i]), out[i]);
+		}
+	}
+
+	/// @brief 親インデックス配列に従いローカル行列を親から順に連結する
+	/// @brief out_world[i] = local[i] * out_world[parent_indices[i]] (親がいない場合は local[i] * root)
+	/// @param local 各フレームのローカル行列
+	/// @param parent_indices 各フレームの親のインデックス (親は必ず子より前に並ぶこと。ルートは-1)
+	/// @param out_world 連結後のワールド行列を格納
+	/// @param num 行列の数
+	/// @param root ルートに掛ける行列 (モデルのワールド行列など)
+	inline void ConcatenateHierarchy(const MATRIX* local, const int* parent_indices, MATRIX* out_world, const size_t num, const MATRIX& root)
+	{
+		const auto root_rhs = detail::LoadMultiplyRhs(root);
+		for (size_t i = 0; i < num; ++i)
+		{
+			const auto parent_index = parent_indices[i];
+			if (parent_index < 0)
+			{
+				detail::MultiplyRows(local[i], root_rhs, out_world[i]);
+				continue;
+			}
+
+			detail::MultiplyRows(local[i], detail::LoadMultiplyRhs(out_world[parent_index]), out_world[i]);
+		}
+	}
+
+	/// @brief 親インデックス配列に従いローカル行列を親から順に連結する
+	/// @brief out_world[i] = local[i] * out_world[parent_indices[i]] (親がいない場合は local[i])
+	/// @param local 各フレームのローカル行列
+	/// @param parent_indices 各フレームの親のインデックス (親は必ず子より前に並ぶこと。ルートは-1)
+	/// @param out_world 連結後のワールド行列を格納
+	/// @param num 行列の数
+	inline void ConcatenateHierarchy(const MATRIX* local, const int* parent_indices, MATRIX* out_world, const size_t num)
+	{
+		for (size_t i = 0; i < num; ++i)
+		{
+			const auto parent_index = parent_indices[i];
+			if (parent_index < 0)
+			{
+				out_world[i] = local[i];
+				continue;
+			}
+
+			detail::MultiplyRows(local[i], detail::LoadMultiplyRhs(out_world[parent_index]), out_world[i]);
+		}
+	}
+}
+
+constexpr MATRIX operator+ (const MATRIX& mat1, const MATRIX& mat2)
+{
+	if (!std::is_constant_evaluated()) { return MAdd(mat1, mat2); }
+
+	MATRIX result{};
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int j = 0; j < 4; ++j) { result.m[i][j] = mat1.m[i][j] + mat2.m[i][j]; }
+	}
+	return result;
+}
+
+constexpr MATRIX operator* (const MATRIX& mat1, const MATRIX& mat2)	{ return matrix::Multiply(mat1, mat2); }
+
+constexpr MATRIX operator* (const MATRIX& mat, const float scale)
+{
+	if (!std::is_constant_evaluated()) { return MScale(mat, scale); }
+
+	MATRIX result{};
+	for (int i = 0; i < 4; ++i)
+	{
+		for (int j = 0; j < 4; ++j) { result.m[i][j] = mat.m[i][j] * scale; }
+	}
+	return result;
+}
+constexpr MATRIX operator* (const float scale, const MATRIX& mat)		{ return mat * scale; }
+
+constexpr MATRIX operator+=(MATRIX& mat1, const MATRIX& mat2)			{ mat1 = mat1 + mat2; return mat1; }
+constexpr MATRIX operator*=(MATRIX& mat1, const MATRIX& mat2)			{ mat1 = mat1 * mat2; return mat1; }
 
 template<typename ScaleT>
-inline MATRIX operator*=(MATRIX& mat, const ScaleT scale)			{ mat = mat * scale; return mat; }
+constexpr MATRIX operator*=(MATRIX& mat, const ScaleT scale)			{ mat = mat * scale; return mat; }
 
-inline bool operator==(const MATRIX& mat1, const MATRIX& mat2)
+constexpr bool operator==(const MATRIX& mat1, const MATRIX& mat2)
 {
 	for (int i = 0; i < 4; ++i)
 	{
@@ -28,14 +240,54 @@ inline bool operator==(const MATRIX& mat1, const MATRIX& mat2)
 	}
 	return true;
 }
-inline bool operator!=(const MATRIX& mat1, const MATRIX& mat2) { return !(mat1 == mat2); }
+constexpr bool operator!=(const MATRIX& mat1, const MATRIX& mat2) { return !(mat1 == mat2); }
+
+/// @brief 座標・スケール・回転に分解した行列
+struct DecomposedMatrix
+{
+	VECTOR pos;
+	VECTOR scale;
+	MATRIX rot;		// スケールを除いた回転行列 (座標成分は0)
+};
 
 namespace matrix
 {
+	/// @brief 単位行列を生成 (MGetIdentと同じ結果をコンパイル時にも求められる)
+	[[nodiscard]] constexpr MATRIX GetIdent()
+	{
+		MATRIX mat{};
+		mat.m[0][0] = 1.0f;
+		mat.m[1][1] = 1.0f;
+		mat.m[2][2] = 1.0f;
+		mat.m[3][3] = 1.0f;
+		return mat;
+	}
+
+	/// @brief 平行移動行列を生成 (MGetTranslateと同じ結果をコンパイル時にも求められる)
+	[[nodiscard]] constexpr MATRIX CreateTranslateMatrix(const VECTOR& pos)
+	{
+		auto mat = GetIdent();
+		mat.m[3][0] = pos.x;
+		mat.m[3][1] = pos.y;
+		mat.m[3][2] = pos.z;
+		return mat;
+	}
+
+	/// @brief 拡大行列を生成 (MGetScaleと同じ結果をコンパイル時にも求められる)
+	[[nodiscard]] constexpr MATRIX CreateScaleMatrix(const VECTOR& scale)
+	{
+		MATRIX mat{};
+		mat.m[0][0] = scale.x;
+		mat.m[1][1] = scale.y;
+		mat.m[2][2] = scale.z;
+		mat.m[3][3] = 1.0f;
+		return mat;
+	}
+
 	/// @brief X軸回転(ピッチ軸回転)をcosθ、sinθから生成
-	[[nodiscard]] inline MATRIX CreateXMatrix(const float cos_theta, const float sin_theta)
+	[[nodiscard]] constexpr MATRIX CreateXMatrix(const float cos_theta, const float sin_theta)
 	{
-		auto mat = MGetIdent();
+		MATRIX mat{};
 		mat.m[0][0] = 1.0f;			mat.m[0][1] = 0.0f;			mat.m[0][2] = 0.0f;			mat.m[0][3] = 0.0f;
 		mat.m[1][0] = 0.0f;			mat.m[1][1] =  cos_theta;	mat.m[1][2] = sin_theta;	mat.m[1][3] = 0.0f;
 		mat.m[2][0] = 0.0f;			mat.m[2][1] = -sin_theta;	mat.m[2][2] = cos_theta;	mat.m[2][3] = 0.0f;
@@ -44,9 +296,9 @@ namespace matrix
 	}
 
 	/// @brief Y軸回転(ヨー軸回転)をcosθ、sinθから生成
-	[[nodiscard]] inline MATRIX CreateYMatrix(const float cos_theta, const float sin_theta)
+	[[nodiscard]] constexpr MATRIX CreateYMatrix(const float cos_theta, const float sin_theta)
 	{
-		auto mat = MGetIdent();
+		MATRIX mat{};
 		mat.m[0][0] = cos_theta;	mat.m[0][1] = 0.0f;			mat.m[0][2] = -sin_theta;	mat.m[0][3] = 0.0f;
 		mat.m[1][0] = 0.0f;			mat.m[1][1] = 1.0f;			mat.m[1][2] = 0.0f;			mat.m[1][3] = 0.0f;
 		mat.m[2][0] = sin_theta;	mat.m[2][1] = 0.0f;			mat.m[2][2] =  cos_theta;	mat.m[2][3] = 0.0f;
@@ -55,9 +307,9 @@ namespace matrix
 	}
 
 	/// @brief Z軸回転(ロール軸回転)をcosθ、sinθから生成
-	[[nodiscard]] inline MATRIX CreateZMatrix(const float cos_theta, const float sin_theta)
+	[[nodiscard]] constexpr MATRIX CreateZMatrix(const float cos_theta, const float sin_theta)
 	{
-		auto mat = MGetIdent();
+		MATRIX mat{};
 		mat.m[0][0] =  cos_theta;	mat.m[0][1] = sin_theta;	mat.m[0][2] = 0.0f;			mat.m[0][3] = 0.0f;
 		mat.m[1][0] = -sin_theta;	mat.m[1][1] = cos_theta;	mat.m[1][2] = 0.0f;			mat.m[1][3] = 0.0f;
 		mat.m[2][0] = 0.0f;			mat.m[2][1] = 0.0f;			mat.m[2][2] = 1.0f;			mat.m[2][3] = 0.0f;
@@ -66,7 +318,7 @@ namespace matrix
 	}
 
 	/// @brief 行列の座標成分を取得
-	[[nodiscard]] inline VECTOR GetPos(const MATRIX& mat)
+	[[nodiscard]] constexpr VECTOR GetPos(const MATRIX& mat)
 	{
 		return { mat.m[3][0], mat.m[3][1], mat.m[3][2] };
 	}
@@ -95,7 +347,7 @@ namespace matrix
 	}
 
 	/// @brief 行列に座標成分を設定
-	inline void SetPos(MATRIX& mat, const VECTOR& pos)
+	constexpr void SetPos(MATRIX& mat, const VECTOR& pos)
 	{
 		mat.m[3][0] = pos.x;
 		mat.m[3][1] = pos.y;
@@ -148,6 +400,62 @@ namespace matrix
 		mat.m[2][2] = rot_mat.m[2][2] * scale.z;
 	}
 
+	/// @brief 行列を座標・スケール・回転に一度で分解する
+	/// @brief GetPos、GetScale、GetRotMatrixを個別に呼ぶ場合と異なり、平方根は各軸1回ずつのみ計算する
+	/// @brief スケールが0の軸の回転成分は0となる
+	[[nodiscard]] inline DecomposedMatrix Decompose(const MATRIX& mat)
+	{
+		DecomposedMatrix result;
+		result.pos = { mat.m[3][0], mat.m[3][1], mat.m[3][2] };
+
+		float* const scale[3] = { &result.scale.x, &result.scale.y, &result.scale.z };
+		for (int i = 0; i < 3; ++i)
+		{
+			const auto size = std::sqrt(mat.m[i][0] * mat.m[i][0] + mat.m[i][1] * mat.m[i][1] + mat.m[i][2] * mat.m[i][2]);
+			const auto inv  = size != 0.0f ? 1.0f / size : 0.0f;
+
+			*scale[i]			= size;
+			result.rot.m[i][0]	= mat.m[i][0] * inv;
+			result.rot.m[i][1]	= mat.m[i][1] * inv;
+			result.rot.m[i][2]	= mat.m[i][2] * inv;
+			result.rot.m[i][3]	= 0.0f;
+		}
+
+		result.rot.m[3][0] = 0.0f;
+		result.rot.m[3][1] = 0.0f;
+		result.rot.m[3][2] = 0.0f;
+		result.rot.m[3][3] = 1.0f;
+		return result;
+	}
+
+	/// @brief 座標・スケール・回転から行列を生成する
+	/// @brief スケール → 回転 → 平行移動 の順に適用される
+	[[nodiscard]] constexpr MATRIX Compose(const VECTOR& pos, const VECTOR& scale, const MATRIX& rot_mat)
+	{
+		const float scales[3] = { scale.x, scale.y, scale.z };
+
+		MATRIX mat{};
+		for (int i = 0; i < 3; ++i)
+		{
+			mat.m[i][0] = rot_mat.m[i][0] * scales[i];
+			mat.m[i][1] = rot_mat.m[i][1] * scales[i];
+			mat.m[i][2] = rot_mat.m[i][2] * scales[i];
+			mat.m[i][3] = 0.0f;
+		}
+
+		mat.m[3][0] = pos.x;
+		mat.m[3][1] = pos.y;
+		mat.m[3][2] = pos.z;
+		mat.m[3][3] = 1.0f;
+		return mat;
+	}
+
+	/// @brief 分解した行列から行列を生成する
+	[[nodiscard]] constexpr MATRIX Compose(const DecomposedMatrix& decomposed)
+	{
+		return Compose(decomposed.pos, decomposed.scale, decomposed.rot);
+	}
+
 	inline void Draw(const int x, const int y, const MATRIX& mat)
 	{
 		for (int i = 0; i < 4; ++i)
@@ -166,8 +474,15 @@ namespace matrix
 #pragma region from / to JSON
 namespace DxLib
 {
+	/// @brief 4x4の2次元配列と16要素の1次元配列のどちらも読み込める
 	inline void from_json(const nlohmann::json& data, MATRIX& mat)
 	{
+		if (data.is_array() && data.size() == 16)
+		{
+			for (int i = 0; i < 16; ++i) { data.at(i).get_to(mat.m[i / 4][i % 4]); }
+			return;
+		}
+
 		auto m = data.get<std::array<std::array<float, 4>, 4>>();
 		for (int i = 0; i < 4; ++i)
 		{
@@ -178,8 +493,16 @@ namespace DxLib
 		}
 	}
 
+	/// @brief json_loader::IsCompactEncodingが有効な場合は16要素の1次元配列で書き出す
 	inline void to_json(nlohmann::json& data, const MATRIX& mat)
 	{
+		if (json_loader::IsCompactEncoding())
+		{
+			data = nlohmann::json::array();
+			for (int i = 0; i < 16; ++i) { data.emplace_back(mat.m[i / 4][i % 4]); }
+			return;
+		}
+
 		std::array<std::array<float, 4>, 4> m{};
 		for (int i = 0; i < 4; ++i)
 		{
@@ -189,7 +512,7 @@ namespace DxLib
 			}
 		}
 
-		data = mat;
+		data = m;
 	}
 }
 #pragma endregion
@@ -2,11 +2,195 @@
 #include <Axis/axis.hpp>
 #include <Matrix/matrix.hpp>
 #include <JSON/json_loader.hpp>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 /// @brief mixamoモデル用のヘルパー関数
 /// @brief MEMO : 配布を行うため、既存の自作関数およびクラスは使用しないものとする
 namespace mixamo_helper
 {
+    /// @brief mixamoのフレーム階層ファイルパス
+    constexpr auto kFrameHierarchyFilePath = "DxLib_HelperLibrary/Data/JSON_Data/mixamo_frame_hierarchy.json";
+
+    /// @brief 事前コンパイル済みのフレーム階層
+    /// @brief 親フレームが必ず子フレームより前に並ぶ (先行順)
+    struct Skeleton
+    {
+        std::vector<std::string> frame_names;       // フレーム名
+        std::vector<int>         parent_indices;    // 親フレームのインデックス (ルートは-1)
+        std::vector<int>         child_counts;      // 子フレームの数
+        std::vector<int>         subtree_sizes;     // 自身を含む子孫フレームの数 (自身から連続して並ぶ)
+    };
+
+    /// @brief フレーム階層のJSONデータをスケルトンにコンパイルする
+    /// @param hierarchy フレーム名をキーとした入れ子のJSONデータ
+    [[nodiscard]] inline Skeleton CompileSkeleton(const nlohmann::json& hierarchy)
+    {
+        Skeleton skeleton;
+
+        // コンパイル時のみの処理のため再帰で辿る
+        std::function<void(const nlohmann::json&, const int)> Compile;
+
+        Compile = [&](const nlohmann::json& node, const int parent_index)
+        {
+            for (auto itr = node.begin(); itr != node.end(); ++itr)
+            {
+                const auto index = static_cast<int>(skeleton.frame_names.size());
+                skeleton.frame_names   .emplace_back(itr.key());
+                skeleton.parent_indices.emplace_back(parent_index);
+                skeleton.child_counts  .emplace_back(static_cast<int>(itr.value().size()));
+                skeleton.subtree_sizes .emplace_back(1);
+
+                Compile(itr.value(), index);
+
+                // 先行順のため子孫は自身の直後に連続して並ぶ
+                skeleton.subtree_sizes[index] = static_cast<int>(skeleton.frame_names.size()) - index;
+            }
+        };
+
+        Compile(hierarchy, -1);
+        return skeleton;
+    }
+
+    /// @brief フレーム階層ファイルを読み込みスケルトンにコンパイルする
+    /// @param file_path フレーム階層のJSONファイルパス
+    /// @param out_skeleton コンパイル後のスケルトンを格納
+    /// @return true : 読み込み成功, false : 読み込み失敗
+    [[nodiscard]] inline bool LoadSkeleton(const std::string_view& file_path, Skeleton& out_skeleton)
+    {
+        nlohmann::json j_data;
+        if (!json_loader::Load(file_path, j_data)) { return false; }
+
+        out_skeleton = CompileSkeleton(j_data);
+        return true;
+    }
+
+    /// @brief mixamoの共通スケルトンを取得する
+    /// @brief 階層はモデルに依存しないため、初回呼び出し時に一度だけ読み込み全モデルで共有する
+    [[nodiscard]] inline const Skeleton& GetSkeleton()
+    {
+        static Skeleton skeleton;
+
+        // 読み込みに失敗していた場合は次回呼び出し時に再試行する
+        if (skeleton.frame_names.empty()) { static_cast<void>(LoadSkeleton(kFrameHierarchyFilePath, skeleton)); }
+
+        return skeleton;
+    }
+
+    /// @brief スケルトンのフレームを親から子の順に1回のループで辿る
+    /// @brief 再帰・型消去・ヒープ確保を行わないため、描画や姿勢計算など毎フレームの処理に使用できる
+    /// @param skeleton 辿るスケルトン
+    /// @param func 各フレームで呼び出す関数 (int bone_index, int parent_index)
+    /// @param func boolを返す場合、falseでそのフレームの子孫を飛ばす
+    /// @param root_index 辿り始めるフレームのインデックス (初期値 : 0)
+    template<typename FuncT>
+    inline void TraverseSkeleton(const Skeleton& skeleton, FuncT&& func, const int root_index = 0)
+    {
+        if (root_index < 0 || root_index >= static_cast<int>(skeleton.subtree_sizes.size())) { return; }
+
+        const auto end_index = root_index + skeleton.subtree_sizes[root_index];
+        for (int i = root_index; i < end_index; )
+        {
+            if constexpr (std::is_same_v<std::invoke_result_t<FuncT&, int, int>, bool>)
+            {
+                // 子孫は連続して並ぶため、飛ばす場合は子孫の数だけ進める
+                i += func(i, skeleton.parent_indices[i]) ? 1 : skeleton.subtree_sizes[i];
+            }
+            else
+            {
+                func(i, skeleton.parent_indices[i]);
+                ++i;
+            }
+        }
+    }
+
+    /// @brief スケルトンとモデルのフレームインデックスの対応表
+    struct BoneBinding
+    {
+        const Skeleton*  skeleton  = nullptr;   // 対応付けたスケルトン
+        int              frame_num = 0;         // 対応付け時のモデルのフレーム数
+        std::vector<int> frame_indices;         // スケルトンの各フレームに対応するモデルのフレームインデックス (見つからない場合は-1)
+    };
+
+    /// @brief スケルトンの全フレーム名をモデルのフレームインデックスに解決する
+    /// @param model_handle モデルハンドル
+    /// @param skeleton 対応付けるスケルトン
+    [[nodiscard]] inline BoneBinding CreateBoneBinding(const int model_handle, const Skeleton& skeleton)
+    {
+        BoneBinding binding;
+        binding.skeleton  = &skeleton;
+        binding.frame_num = MV1GetFrameNum(model_handle);
+        binding.frame_indices.reserve(skeleton.frame_names.size());
+
+        for (const auto& frame_name : skeleton.frame_names)
+        {
+            binding.frame_indices.emplace_back(MV1SearchFrame(model_handle, frame_name.c_str()));
+        }
+
+        return binding;
+    }
+
+    namespace detail
+    {
+        /// @brief モデルハンドルをキーとした対応表のキャッシュ
+        [[nodiscard]] inline std::unordered_map<int, BoneBinding>& GetBoneBindingCache()
+        {
+            static std::unordered_map<int, BoneBinding> cache;
+            return cache;
+        }
+    }
+
+    /// @brief キャッシュ済みの対応表を取得する
+    /// @brief 初回呼び出し時のみフレーム名の検索を行い、以降は整数の参照のみとなる
+    /// @brief 削除済みのハンドル、別のスケルトン、フレーム数の異なるモデルを検出した場合は対応表を作り直す
+    /// @param model_handle モデルハンドル
+    /// @param skeleton 対応付けるスケルトン (キャッシュはアドレスで識別するため、呼び出し間で同じインスタンスを渡すこと)
+    /// @return 対応表 (モデルハンドルが無効な場合はnullptr)
+    [[nodiscard]] inline const BoneBinding* GetBoneBinding(const int model_handle, const Skeleton& skeleton)
+    {
+        auto&      cache     = detail::GetBoneBindingCache();
+        const auto frame_num = MV1GetFrameNum(model_handle);
+
+        // 削除済みのハンドル
+        if (frame_num <= -1)
+        {
+            cache.erase(model_handle);
+            return nullptr;
+        }
+
+        auto itr = cache.find(model_handle);
+        if (itr == cache.end() || itr->second.skeleton != &skeleton || itr->second.frame_num != frame_num)
+        {
+            itr = cache.insert_or_assign(model_handle, CreateBoneBinding(model_handle, skeleton)).first;
+        }
+
+        return &itr->second;
+    }
+
+    /// @brief モデルハンドルの対応表をキャッシュから破棄する
+    inline void ReleaseBoneBinding(const int model_handle)
+    {
+        detail::GetBoneBindingCache().erase(model_handle);
+    }
+
+    /// @brief 全ての対応表をキャッシュから破棄する
+    inline void ReleaseAllBoneBindings()
+    {
+        detail::GetBoneBindingCache().clear();
+    }
+
+    /// @brief 対応表を破棄してからモデルを削除する
+    /// @param model_handle モデルハンドル
+    /// @return MV1DeleteModelの戻り値
+    inline int DeleteModel(const int model_handle)
+    {
+        ReleaseBoneBinding(model_handle);
+        return MV1DeleteModel(model_handle);
+    }
+
     /// @brief 回転行列をXYZ軸に変換する
     /// @param rot_matrix 変換対象の回転行列
     /// @param out_right 変換後のX軸を格納
@@ -16,76 +200,156 @@ namespace mixamo_helper
     {
         // 回転行列を取得
         const auto rot      = matrix::GetRotMatrix(rot_matrix);
-        const auto x_axis   = v3d::GetNormalizedV(VGet(rot.m[0][0], rot.m[0][1], rot.m[0][2]));
-        const auto y_axis   = v3d::GetNormalizedV(VGet(rot.m[1][0], rot.m[1][1], rot.m[1][2]));
-        const auto z_axis   = v3d::GetNormalizedV(VGet(rot.m[2][0], rot.m[2][1], rot.m[2][2]));
+        const auto x_axis   = v3d::GetNormalizedVFast(VGet(rot.m[0][0], rot.m[0][1], rot.m[0][2]));
+        const auto y_axis   = v3d::GetNormalizedVFast(VGet(rot.m[1][0], rot.m[1][1], rot.m[1][2]));
+        const auto z_axis   = v3d::GetNormalizedVFast(VGet(rot.m[2][0], rot.m[2][1], rot.m[2][2]));
 
         return { x_axis, y_axis, z_axis };
     }
 
-	/// @brief モデルのフレームを描画する
-	/// @param model_handle モデルハンドル
+    /// @brief フレームの姿勢
+    struct BonePose
+    {
+        MATRIX world_matrix;    // ワールド行列
+        VECTOR pos;             // ワールド座標
+        Axis   axis;            // 正規化済みのXYZ軸
+        bool   is_valid;        // モデルにフレームが存在するかどうか
+    };
+
+    /// @brief スケルトン全体の姿勢のスナップショット
+    /// @brief スケルトンと同じ順に並ぶ
+    struct Pose
+    {
+        std::vector<BonePose> bones;
+    };
+
+    /// @brief スケルトンのフレームインデックスを取得する
+    /// @return フレームインデックス (見つからない場合は-1)
+    [[nodiscard]] inline int FindBoneIndex(const Skeleton& skeleton, const std::string_view& frame_name)
+    {
+        const auto frame_num = static_cast<int>(skeleton.frame_names.size());
+        for (int i = 0; i < frame_num; ++i)
+        {
+            if (skeleton.frame_names[i] == frame_name) { return i; }
+        }
+        return -1;
+    }
+
+    /// @brief モデルの全フレームの姿勢を一度に取得する
+    /// @brief 行列の取得、座標・XYZ軸の算出はフレームごとに一度だけ行う
+    /// @param model_handle モデルハンドル
+    /// @param skeleton 取得するスケルトン
+    /// @param out_pose 取得した姿勢を格納 (確保済みの領域は使い回す)
+    /// @return true : 取得成功, false : モデルハンドルが無効
+    inline bool CapturePose(const int model_handle, const Skeleton& skeleton, Pose& out_pose)
+    {
+        const auto binding = GetBoneBinding(model_handle, skeleton);
+        if (!binding) { return false; }
+
+        out_pose.bones.resize(skeleton.frame_names.size());
+
+        TraverseSkeleton(skeleton, [&](const int bone_index, const int)
+        {
+            auto&      bone        = out_pose.bones[bone_index];
+            const auto frame_index = binding->frame_indices[bone_index];
+
+            bone.is_valid = frame_index > -1;
+            if (!bone.is_valid) { return; }
+
+            bone.world_matrix   = MV1GetFrameLocalWorldMatrix(model_handle, frame_index);
+            bone.pos            = MGetTranslateElem(bone.world_matrix);
+            bone.axis           = ConvertRotMatrixToAxis(bone.world_matrix);
+        });
+
+        return true;
+    }
+
+	/// @brief 取得済みの姿勢からフレームを描画する
+	/// @param skeleton 事前コンパイル済みのフレーム階層
+	/// @param pose CapturePoseで取得した姿勢
 	/// @param is_draw_joint 関節を描画するかどうか (初期値 : true)
 	/// @param is_draw_frame ボーンを描画するかどうか (初期値 : true)
 	/// @param is_draw_axis 関節のXYZ軸を描画するかどうか (初期値 : true)
 	/// @param is_fill 関節及びボーンを塗りつぶすかどうか (初期値 : true)
-    inline void DrawFrames(const int model_handle, const bool is_draw_joint = true, const bool is_draw_frame = true, const bool is_draw_axis = true, const bool is_fill = true)
+    inline void DrawFrames(const Skeleton& skeleton, const Pose& pose, const bool is_draw_joint = true, const bool is_draw_frame = true, const bool is_draw_axis = true, const bool is_fill = true)
 	{
-		nlohmann::json j_data;
-        if (!json_loader::Load("DxLib_HelperLibrary/Data/JSON_Data/mixamo_frame_hierarchy.json", j_data)) { return; }
-		
-        // 最下層フレーム
-		const auto  hips    = j_data.at("Armature").at("mixamorig:Hips");
-        auto        hips_m  = MV1GetFrameLocalWorldMatrix(model_handle, MV1SearchFrame(model_handle, "mixamorig:Hips"));
+        // Armature(ルート)とHips(最下層フレーム)が必要
+        if (skeleton.frame_names.size() < 2 || pose.bones.size() < skeleton.frame_names.size()) { return; }
 
-        // 子を辿る再帰関数を定義
-        std::function<void(const nlohmann::json&, MATRIX&)> Traverse;
+        constexpr int armature_index = 0;
+        constexpr int hips_index     = 1;
 
-        Traverse = [&](const nlohmann::json& node, MATRIX& parent_matrix)
+        // 最下層フレームから辿る
+        TraverseSkeleton(skeleton, [&](const int bone_index, const int parent_index)
         {
-            for (auto itr = node.begin(); itr != node.end(); ++itr)
+            const auto& child = pose.bones[bone_index];
+            if (!child.is_valid) { return false; }
+
+            // 最下層フレームは親としてのみ扱う
+            if (bone_index == hips_index) { return true; }
+
+            const auto& parent      = pose.bones[parent_index];
+            const auto  distance    = VSize(child.pos - parent.pos);
+            const auto  radius      = distance * 0.2f;
+            const auto  axis_length = distance * 0.6f;
+
+            // 関節・ボーン・XYZ軸の描画
+            if (is_draw_joint)  { DrawSphere3D(parent.pos, radius, 6, 0xffffff, 0xffffff, is_fill); }
+            if (is_draw_frame ) { DrawCone3D(child.pos, parent.pos, radius, 6, 0xffffff, 0xffffff, is_fill); }
+            if (is_draw_axis )  { axis::Draw(parent.axis, parent.pos, axis_length); }
+
+            // 子がいない場合、関節・XYZ軸のみ描画
+            if (skeleton.child_counts[bone_index] == 0)
             {
-                const auto frame_name   = itr.key();
-                const auto frame_index  = MV1SearchFrame(model_handle, frame_name.c_str());
-                if (frame_index <= -1) { continue; }
-
-                auto       child_m      = MV1GetFrameLocalWorldMatrix(model_handle, frame_index);
-                const auto child_pos    = MGetTranslateElem(child_m);
-                const auto parent_pos   = MGetTranslateElem(parent_matrix);
-                const auto distance     = VSize(child_pos - parent_pos);
-                const auto radius       = distance * 0.2f;
-                const auto axis_length  = distance * 0.6f;
-                const auto parent_axis  = ConvertRotMatrixToAxis(parent_matrix);
-
-                // 関節・ボーン・XYZ軸の描画
-                if (is_draw_joint)  { DrawSphere3D(parent_pos, radius, 6, 0xffffff, 0xffffff, is_fill); }
-                if (is_draw_frame ) { DrawCone3D(child_pos, parent_pos, radius, 6, 0xffffff, 0xffffff, is_fill); }
-                if (is_draw_axis )  { axis::Draw(parent_axis, parent_pos, axis_length); }
-
-                // 子がいないため再帰しない
-                if (itr.value().empty())
-                {
-                    const auto child_axis = ConvertRotMatrixToAxis(child_m);
-                    
-                    // 子がいない場合、関節・XYZ軸のみ描画
-                    if (is_draw_joint) { DrawSphere3D(child_pos, radius, 6, 0xffffff, 0xffffff, is_fill); }
-                    if (is_draw_axis)  { axis::Draw(child_axis, child_pos, axis_length); }
-
-                    continue;
-                }
-
-                // 子がいるため再帰
-                Traverse(itr.value(), child_m);
+                if (is_draw_joint) { DrawSphere3D(child.pos, radius, 6, 0xffffff, 0xffffff, is_fill); }
+                if (is_draw_axis)  { axis::Draw(child.axis, child.pos, axis_length); }
             }
-        };
 
-        Traverse(hips, hips_m);
+            return true;
+        }, hips_index);
 
         // Armatureの描画
-        auto armature_m             = MV1GetFrameLocalWorldMatrix(model_handle, MV1SearchFrame(model_handle, "Armature"));
-        const auto armature_pos     = MGetTranslateElem(armature_m);
-        const auto armature_axis    = ConvertRotMatrixToAxis(armature_m);
-        axis::Draw(armature_axis, armature_pos, 5.0f);
-        DrawSphere3D(armature_pos, 1, 8, 0xffffff, 0xffffff, FALSE);
+        const auto& armature = pose.bones[armature_index];
+        if (!armature.is_valid) { return; }
+
+        axis::Draw(armature.axis, armature.pos, 5.0f);
+        DrawSphere3D(armature.pos, 1, 8, 0xffffff, 0xffffff, FALSE);
+	}
+
+    namespace detail
+    {
+        /// @brief 描画用の作業領域
+        /// @brief 一度確保した領域を使い回し、毎フレームのヒープ確保を避ける
+        [[nodiscard]] inline Pose& GetPoseBuffer()
+        {
+            static Pose pose;
+            return pose;
+        }
+    }
+
+	/// @brief モデルのフレームを描画する
+	/// @param model_handle モデルハンドル
+	/// @param skeleton 事前コンパイル済みのフレーム階層
+	/// @param is_draw_joint 関節を描画するかどうか (初期値 : true)
+	/// @param is_draw_frame ボーンを描画するかどうか (初期値 : true)
+	/// @param is_draw_axis 関節のXYZ軸を描画するかどうか (初期値 : true)
+	/// @param is_fill 関節及びボーンを塗りつぶすかどうか (初期値 : true)
+    inline void DrawFrames(const int model_handle, const Skeleton& skeleton, const bool is_draw_joint = true, const bool is_draw_frame = true, const bool is_draw_axis = true, const bool is_fill = true)
+	{
+        auto& pose = detail::GetPoseBuffer();
+        if (!CapturePose(model_handle, skeleton, pose)) { return; }
+
+        DrawFrames(skeleton, pose, is_draw_joint, is_draw_frame, is_draw_axis, is_fill);
+	}
+
+	/// @brief モデルのフレームを描画する
+	/// @param model_handle モデルハンドル
+	/// @param is_draw_joint 関節を描画するかどうか (初期値 : true)
+	/// @param is_draw_frame ボーンを描画するかどうか (初期値 : true)
+	/// @param is_draw_axis 関節のXYZ軸を描画するかどうか (初期値 : true)
+	/// @param is_fill 関節及びボーンを塗りつぶすかどうか (初期値 : true)
+    inline void DrawFrames(const int model_handle, const bool is_draw_joint = true, const bool is_draw_frame = true, const bool is_draw_axis = true, const bool is_fill = true)
+	{
+        DrawFrames(model_handle, GetSkeleton(), is_draw_joint, is_draw_frame, is_draw_axis, is_fill);
 	}
 }
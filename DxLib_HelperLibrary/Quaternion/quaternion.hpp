@@ -0,0 +1,323 @@
+﻿#pragma once
+#include <cmath>
+#include <Axis/axis.hpp>
+#include <Matrix/matrix.hpp>
+#include <SIMD/simd.hpp>
+
+/// @brief 回転を表すクォータニオン (16バイト)
+/// @brief (x, y, z) : 虚部, w : 実部
+struct Quaternion
+{
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+inline Quaternion operator- (const Quaternion& q)	{ return { -q.x, -q.y, -q.z, -q.w }; }
+
+/// @brief クォータニオンの積
+/// @brief MATRIXの積と同じく、q1の回転の後にq2の回転を行う (ToMatrix(q1 * q2) == ToMatrix(q1) * ToMatrix(q2))
+inline Quaternion operator* (const Quaternion& q1, const Quaternion& q2)
+{
+	return {
+		q2.w * q1.x + q2.x * q1.w + q2.y * q1.z - q2.z * q1.y,
+		q2.w * q1.y - q2.x * q1.z + q2.y * q1.w + q2.z * q1.x,
+		q2.w * q1.z + q2.x * q1.y - q2.y * q1.x + q2.z * q1.w,
+		q2.w * q1.w - q2.x * q1.x - q2.y * q1.y - q2.z * q1.z
+	};
+}
+
+inline Quaternion operator*=(Quaternion& q1, const Quaternion& q2) { q1 = q1 * q2; return q1; }
+
+inline bool operator==(const Quaternion& q1, const Quaternion& q2) { return q1.x == q2.x && q1.y == q2.y && q1.z == q2.z && q1.w == q2.w; }
+inline bool operator!=(const Quaternion& q1, const Quaternion& q2) { return !(q1 == q2); }
+
+/// @brief 座標・スケール・回転(クォータニオン)に分解した行列
+struct DecomposedMatrixQ
+{
+	VECTOR		pos;
+	VECTOR		scale;
+	Quaternion	rot;
+};
+
+namespace quaternion
+{
+	/// @brief 回転なしのクォータニオンを取得
+	[[nodiscard]] inline Quaternion GetIdent() { return { 0.0f, 0.0f, 0.0f, 1.0f }; }
+
+	/// @brief 内積を求める
+	[[nodiscard]] inline float GetDot(const Quaternion& q1, const Quaternion& q2) { return q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w; }
+
+	/// @brief 共役クォータニオンを取得 (正規化済みの場合は逆回転となる)
+	[[nodiscard]] inline Quaternion GetConjugate(const Quaternion& q) { return { -q.x, -q.y, -q.z, q.w }; }
+
+	/// @brief 正規化したクォータニオンを取得
+	[[nodiscard]] inline Quaternion GetNormalized(const Quaternion& q)
+	{
+		const auto size = std::sqrt(GetDot(q, q));
+		if (size == 0.0f) { return GetIdent(); }
+
+		const auto inv = 1.0f / size;
+		return { q.x * inv, q.y * inv, q.z * inv, q.w * inv };
+	}
+
+	/// @brief 回転軸と回転角からクォータニオンを生成
+	/// @param axis 正規化済みの回転軸
+	/// @param angle 回転角 (ラジアン)
+	[[nodiscard]] inline Quaternion CreateFromAxisAngle(const VECTOR& axis, const float angle)
+	{
+		const auto half_sin = std::sin(angle * 0.5f);
+		return { axis.x * half_sin, axis.y * half_sin, axis.z * half_sin, std::cos(angle * 0.5f) };
+	}
+
+	/// @brief ベクトルを回転する (VTransform(v, ToMatrix(q)) と同じ結果)
+	[[nodiscard]] inline VECTOR Rotate(const Quaternion& q, const VECTOR& v)
+	{
+		// v + 2w(u×v) + 2u×(u×v)
+		const VECTOR u  = { q.x, q.y, q.z };
+		const VECTOR uv = { u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x };
+		const VECTOR uuv = { u.y * uv.z - u.z * uv.y, u.z * uv.x - u.x * uv.z, u.x * uv.y - u.y * uv.x };
+
+		return v + uv * (2.0f * q.w) + uuv * 2.0f;
+	}
+
+	/// @brief 回転行列からクォータニオンを生成
+	/// @param rot_mat スケールを含まない回転行列
+	[[nodiscard]] inline Quaternion CreateFromRotMatrix(const MATRIX& rot_mat)
+	{
+		const auto& m     = rot_mat.m;
+		const auto  trace = m[0][0] + m[1][1] + m[2][2];
+
+		// 桁落ちを避けるため、最も大きい成分から求める
+		if (trace > 0.0f)
+		{
+			const auto s = 0.5f / std::sqrt(trace + 1.0f);
+			return { (m[1][2] - m[2][1]) * s, (m[2][0] - m[0][2]) * s, (m[0][1] - m[1][0]) * s, 0.25f / s };
+		}
+		if (m[0][0] > m[1][1] && m[0][0] > m[2][2])
+		{
+			const auto s = 0.5f / std::sqrt(1.0f + m[0][0] - m[1][1] - m[2][2]);
+			return { 0.25f / s, (m[1][0] + m[0][1]) * s, (m[2][0] + m[0][2]) * s, (m[1][2] - m[2][1]) * s };
+		}
+		if (m[1][1] > m[2][2])
+		{
+			const auto s = 0.5f / std::sqrt(1.0f + m[1][1] - m[0][0] - m[2][2]);
+			return { (m[1][0] + m[0][1]) * s, 0.25f / s, (m[2][1] + m[1][2]) * s, (m[2][0] - m[0][2]) * s };
+		}
+
+		const auto s = 0.5f / std::sqrt(1.0f + m[2][2] - m[0][0] - m[1][1]);
+		return { (m[2][0] + m[0][2]) * s, (m[2][1] + m[1][2]) * s, 0.25f / s, (m[0][1] - m[1][0]) * s };
+	}
+
+	/// @brief クォータニオンを回転行列に変換
+	/// @param q 正規化済みのクォータニオン
+	[[nodiscard]] inline MATRIX ToMatrix(const Quaternion& q)
+	{
+		const auto xx = q.x * q.x;	const auto yy = q.y * q.y;	const auto zz = q.z * q.z;
+		const auto xy = q.x * q.y;	const auto xz = q.x * q.z;	const auto yz = q.y * q.z;
+		const auto wx = q.w * q.x;	const auto wy = q.w * q.y;	const auto wz = q.w * q.z;
+
+		MATRIX mat;
+		mat.m[0][0] = 1.0f - 2.0f * (yy + zz);	mat.m[0][1] = 2.0f * (xy + wz);			mat.m[0][2] = 2.0f * (xz - wy);			mat.m[0][3] = 0.0f;
+		mat.m[1][0] = 2.0f * (xy - wz);			mat.m[1][1] = 1.0f - 2.0f * (xx + zz);	mat.m[1][2] = 2.0f * (yz + wx);			mat.m[1][3] = 0.0f;
+		mat.m[2][0] = 2.0f * (xz + wy);			mat.m[2][1] = 2.0f * (yz - wx);			mat.m[2][2] = 1.0f - 2.0f * (xx + yy);	mat.m[2][3] = 0.0f;
+		mat.m[3][0] = 0.0f;						mat.m[3][1] = 0.0f;						mat.m[3][2] = 0.0f;						mat.m[3][3] = 1.0f;
+		return mat;
+	}
+
+	/// @brief XYZ軸からクォータニオンを生成
+	/// @param axis 正規直交化済みのXYZ軸
+	[[nodiscard]] inline Quaternion CreateFromAxis(const Axis& axis)
+	{
+		MATRIX rot_mat = MGetIdent();
+		rot_mat.m[0][0] = axis.x_axis.x; rot_mat.m[0][1] = axis.x_axis.y; rot_mat.m[0][2] = axis.x_axis.z;
+		rot_mat.m[1][0] = axis.y_axis.x; rot_mat.m[1][1] = axis.y_axis.y; rot_mat.m[1][2] = axis.y_axis.z;
+		rot_mat.m[2][0] = axis.z_axis.x; rot_mat.m[2][1] = axis.z_axis.y; rot_mat.m[2][2] = axis.z_axis.z;
+		return CreateFromRotMatrix(rot_mat);
+	}
+
+	/// @brief クォータニオンをXYZ軸に変換
+	/// @param q 正規化済みのクォータニオン
+	[[nodiscard]] inline Axis ToAxis(const Quaternion& q)
+	{
+		const auto rot_mat = ToMatrix(q);
+		return {
+			VGet(rot_mat.m[0][0], rot_mat.m[0][1], rot_mat.m[0][2]),
+			VGet(rot_mat.m[1][0], rot_mat.m[1][1], rot_mat.m[1][2]),
+			VGet(rot_mat.m[2][0], rot_mat.m[2][1], rot_mat.m[2][2])
+		};
+	}
+
+	/// @brief 正規化線形補間
+	/// @brief 最短経路で補間する。角速度は一定にならないが、Slerpより高速
+	/// @param t 補間率 (0.0f : q1, 1.0f : q2)
+	[[nodiscard]] inline Quaternion Nlerp(const Quaternion& q1, const Quaternion& q2, const float t)
+	{
+		// 逆向きの場合は反転して最短経路を取る
+		const auto t2 = GetDot(q1, q2) < 0.0f ? -t : t;
+		const auto t1 = 1.0f - t;
+
+		return GetNormalized({ q1.x * t1 + q2.x * t2, q1.y * t1 + q2.y * t2, q1.z * t1 + q2.z * t2, q1.w * t1 + q2.w * t2 });
+	}
+
+	/// @brief 球面線形補間
+	/// @brief 最短経路を一定の角速度で補間する。ほぼ同じ向きの場合はNlerpで補間する
+	/// @param t 補間率 (0.0f : q1, 1.0f : q2)
+	[[nodiscard]] inline Quaternion Slerp(const Quaternion& q1, const Quaternion& q2, const float t)
+	{
+		auto dot  = GetDot(q1, q2);
+		auto sign = 1.0f;
+
+		// 逆向きの場合は反転して最短経路を取る
+		if (dot < 0.0f)
+		{
+			dot  = -dot;
+			sign = -1.0f;
+		}
+
+		// 角度が小さい場合はsinθが0に近づき不安定になるため線形補間で代用する
+		if (dot > 0.9995f) { return Nlerp(q1, q2, t); }
+
+		const auto theta	 = std::acos(dot);
+		const auto inv_sin	 = 1.0f / std::sin(theta);
+		const auto t1		 = std::sin((1.0f - t) * theta) * inv_sin;
+		const auto t2		 = std::sin(t * theta) * inv_sin * sign;
+
+		return { q1.x * t1 + q2.x * t2, q1.y * t1 + q2.y * t2, q1.z * t1 + q2.z * t2, q1.w * t1 + q2.w * t2 };
+	}
+
+	/// @brief 配列の各要素を一括で正規化線形補間する (out[i] = Nlerp(q1[i], q2[i], t))
+	/// @brief outはq1またはq2と同じ配列でもよい
+	/// @param num 要素数
+	inline void NlerpArray(const Quaternion* q1, const Quaternion* q2, const float t, Quaternion* out, const size_t num)
+	{
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+		const auto t1	 = _mm_set1_ps(1.0f - t);
+		const auto t2	 = _mm_set1_ps(t);
+		const auto zero	 = _mm_setzero_ps();
+		const auto one	 = _mm_set1_ps(1.0f);
+		const auto ident = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+		for (size_t i = 0; i < num; ++i)
+		{
+			const auto a = _mm_loadu_ps(&q1[i].x);
+			const auto b = _mm_loadu_ps(&q2[i].x);
+
+			// 4成分の内積を全レーンに求める
+			auto dot = _mm_mul_ps(a, b);
+			dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(2, 3, 0, 1)));
+			dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 0, 3, 2)));
+
+			// 逆向きの場合はt2の符号を反転して最短経路を取る (Nlerpと同じく dot < 0 で判定し、-0.0fは反転しない)
+			const auto sign = _mm_and_ps(_mm_cmplt_ps(dot, zero), _mm_set1_ps(-0.0f));
+			const auto lerp = _mm_add_ps(_mm_mul_ps(a, t1), _mm_mul_ps(b, _mm_xor_ps(t2, sign)));
+
+			auto size_sq = _mm_mul_ps(lerp, lerp);
+			size_sq = _mm_add_ps(size_sq, _mm_shuffle_ps(size_sq, size_sq, _MM_SHUFFLE(2, 3, 0, 1)));
+			size_sq = _mm_add_ps(size_sq, _mm_shuffle_ps(size_sq, size_sq, _MM_SHUFFLE(1, 0, 3, 2)));
+
+			// GetNormalizedと同じく、長さが0の場合は回転なしとする
+			const auto normalized = _mm_mul_ps(lerp, _mm_div_ps(one, _mm_sqrt_ps(size_sq)));
+			const auto non_zero	  = _mm_cmpneq_ps(size_sq, zero);
+			_mm_storeu_ps(&out[i].x, _mm_or_ps(_mm_and_ps(non_zero, normalized), _mm_andnot_ps(non_zero, ident)));
+		}
+#else
+		for (size_t i = 0; i < num; ++i)
+		{
+			out[i] = Nlerp(q1[i], q2[i], t);
+		}
+#endif
+	}
+
+	/// @brief 配列の各要素を要素ごとの補間率で一括して正規化線形補間する (out[i] = Nlerp(q1[i], q2[i], t[i]))
+	/// @param num 要素数
+	inline void NlerpArray(const Quaternion* q1, const Quaternion* q2, const float* t, Quaternion* out, const size_t num)
+	{
+		for (size_t i = 0; i < num; ++i)
+		{
+			out[i] = Nlerp(q1[i], q2[i], t[i]);
+		}
+	}
+
+	/// @brief 配列の各要素を一括で球面線形補間する (out[i] = Slerp(q1[i], q2[i], t))
+	/// @param num 要素数
+	inline void SlerpArray(const Quaternion* q1, const Quaternion* q2, const float t, Quaternion* out, const size_t num)
+	{
+		for (size_t i = 0; i < num; ++i)
+		{
+			out[i] = Slerp(q1[i], q2[i], t);
+		}
+	}
+
+	/// @brief 配列の各要素を要素ごとの補間率で一括して球面線形補間する (out[i] = Slerp(q1[i], q2[i], t[i]))
+	/// @param num 要素数
+	inline void SlerpArray(const Quaternion* q1, const Quaternion* q2, const float* t, Quaternion* out, const size_t num)
+	{
+		for (size_t i = 0; i < num; ++i)
+		{
+			out[i] = Slerp(q1[i], q2[i], t[i]);
+		}
+	}
+}
+
+namespace matrix
+{
+	/// @brief 行列を座標・スケール・回転(クォータニオン)に一度で分解する
+	[[nodiscard]] inline DecomposedMatrixQ DecomposeQ(const MATRIX& mat)
+	{
+		const auto decomposed = Decompose(mat);
+		return { decomposed.pos, decomposed.scale, quaternion::CreateFromRotMatrix(decomposed.rot) };
+	}
+
+	/// @brief 座標・スケール・回転(クォータニオン)から行列を生成する
+	[[nodiscard]] inline MATRIX Compose(const VECTOR& pos, const VECTOR& scale, const Quaternion& rot)
+	{
+		return Compose(pos, scale, quaternion::ToMatrix(rot));
+	}
+
+	/// @brief 分解した行列から行列を生成する
+	[[nodiscard]] inline MATRIX Compose(const DecomposedMatrixQ& decomposed)
+	{
+		return Compose(decomposed.pos, decomposed.scale, decomposed.rot);
+	}
+}
+
+
+#pragma region from / to JSON
+/// @brief { "x", "y", "z", "w" } と [x, y, z, w] のどちらも読み込める
+inline void from_json(const nlohmann::json& data, Quaternion& q)
+{
+	if (data.is_array())
+	{
+		data.at(0).get_to(q.x);
+		data.at(1).get_to(q.y);
+		data.at(2).get_to(q.z);
+		data.at(3).get_to(q.w);
+		return;
+	}
+
+	data.at("x").get_to(q.x);
+	data.at("y").get_to(q.y);
+	data.at("z").get_to(q.z);
+	data.at("w").get_to(q.w);
+}
+
+/// @brief json_loader::IsCompactEncodingが有効な場合は [x, y, z, w] で書き出す
+inline void to_json(nlohmann::json& data, const Quaternion& q)
+{
+	if (json_loader::IsCompactEncoding())
+	{
+		data = nlohmann::json::array({ q.x, q.y, q.z, q.w });
+		return;
+	}
+
+	data = nlohmann::json
+	{
+		{ "x",	q.x },
+		{ "y",	q.y },
+		{ "z",	q.z },
+		{ "w",	q.w }
+	};
+}
+#pragma endregion
@@ -0,0 +1,283 @@
+﻿#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+/// @brief 使用するSIMD命令セットをコンパイル時に選択する
+/// @brief コンパイラのターゲット指定(/arch:AVX, -mavx 等)に従い、AVX > SSE2 > スカラーの順に選ばれる
+/// @brief DXLIB_HELPER_NO_SIMD を定義するとスカラー実装に固定される
+#if !defined(DXLIB_HELPER_NO_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define DXLIB_HELPER_SIMD_SSE2 1
+	#endif
+
+	#if defined(DXLIB_HELPER_SIMD_SSE2) && defined(__AVX__)
+		#define DXLIB_HELPER_SIMD_AVX 1
+	#endif
+#endif
+
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+	#include <immintrin.h>
+#endif
+
+/// @brief 配列演算用のSIMDラッパー
+/// @brief 選択された命令セットに応じてレーン数が変わる (AVX : 8, SSE2 : 4, スカラー : 1)
+/// @brief 同じカーネルを命令セットごとに書き分けずに済むよう、演算を関数でまとめる
+namespace simd
+{
+	/// @brief 配列の先頭に要求するアライメント
+	constexpr size_t kAlignment = 32;
+
+#if defined(DXLIB_HELPER_SIMD_AVX)
+	using FloatV = __m256;
+	using MaskV  = __m256;
+	constexpr size_t kFloatLanes = 8;
+
+	[[nodiscard]] inline FloatV Load	(const float* p)						{ return _mm256_load_ps(p); }
+	[[nodiscard]] inline FloatV LoadU	(const float* p)						{ return _mm256_loadu_ps(p); }
+	inline void					Store	(float* p, const FloatV v)				{ _mm256_store_ps(p, v); }
+	inline void					StoreU	(float* p, const FloatV v)				{ _mm256_storeu_ps(p, v); }
+	[[nodiscard]] inline FloatV Set1	(const float f)							{ return _mm256_set1_ps(f); }
+	[[nodiscard]] inline FloatV Add		(const FloatV a, const FloatV b)		{ return _mm256_add_ps(a, b); }
+	[[nodiscard]] inline FloatV Sub		(const FloatV a, const FloatV b)		{ return _mm256_sub_ps(a, b); }
+	[[nodiscard]] inline FloatV Mul		(const FloatV a, const FloatV b)		{ return _mm256_mul_ps(a, b); }
+	[[nodiscard]] inline FloatV Div		(const FloatV a, const FloatV b)		{ return _mm256_div_ps(a, b); }
+	[[nodiscard]] inline FloatV Min		(const FloatV a, const FloatV b)		{ return _mm256_min_ps(a, b); }
+	[[nodiscard]] inline FloatV Max		(const FloatV a, const FloatV b)		{ return _mm256_max_ps(a, b); }
+	[[nodiscard]] inline FloatV Sqrt	(const FloatV a)						{ return _mm256_sqrt_ps(a); }
+	[[nodiscard]] inline FloatV Rsqrt	(const FloatV a)						{ return _mm256_rsqrt_ps(a); }
+	[[nodiscard]] inline MaskV	CmpNeq	(const FloatV a, const FloatV b)		{ return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); }
+	[[nodiscard]] inline MaskV	CmpLt	(const FloatV a, const FloatV b)		{ return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	[[nodiscard]] inline bool	AnyOf	(const MaskV m)							{ return _mm256_movemask_ps(m) != 0; }
+	[[nodiscard]] inline FloatV Select	(const MaskV m, const FloatV a, const FloatV b) { return _mm256_blendv_ps(b, a, m); }
+#elif defined(DXLIB_HELPER_SIMD_SSE2)
+	using FloatV = __m128;
+	using MaskV  = __m128;
+	constexpr size_t kFloatLanes = 4;
+
+	[[nodiscard]] inline FloatV Load	(const float* p)						{ return _mm_load_ps(p); }
+	[[nodiscard]] inline FloatV LoadU	(const float* p)						{ return _mm_loadu_ps(p); }
+	inline void					Store	(float* p, const FloatV v)				{ _mm_store_ps(p, v); }
+	inline void					StoreU	(float* p, const FloatV v)				{ _mm_storeu_ps(p, v); }
+	[[nodiscard]] inline FloatV Set1	(const float f)							{ return _mm_set1_ps(f); }
+	[[nodiscard]] inline FloatV Add		(const FloatV a, const FloatV b)		{ return _mm_add_ps(a, b); }
+	[[nodiscard]] inline FloatV Sub		(const FloatV a, const FloatV b)		{ return _mm_sub_ps(a, b); }
+	[[nodiscard]] inline FloatV Mul		(const FloatV a, const FloatV b)		{ return _mm_mul_ps(a, b); }
+	[[nodiscard]] inline FloatV Div		(const FloatV a, const FloatV b)		{ return _mm_div_ps(a, b); }
+	[[nodiscard]] inline FloatV Min		(const FloatV a, const FloatV b)		{ return _mm_min_ps(a, b); }
+	[[nodiscard]] inline FloatV Max		(const FloatV a, const FloatV b)		{ return _mm_max_ps(a, b); }
+	[[nodiscard]] inline FloatV Sqrt	(const FloatV a)						{ return _mm_sqrt_ps(a); }
+	[[nodiscard]] inline FloatV Rsqrt	(const FloatV a)						{ return _mm_rsqrt_ps(a); }
+	[[nodiscard]] inline MaskV	CmpNeq	(const FloatV a, const FloatV b)		{ return _mm_cmpneq_ps(a, b); }
+	[[nodiscard]] inline MaskV	CmpLt	(const FloatV a, const FloatV b)		{ return _mm_cmplt_ps(a, b); }
+	[[nodiscard]] inline bool	AnyOf	(const MaskV m)							{ return _mm_movemask_ps(m) != 0; }
+	[[nodiscard]] inline FloatV Select	(const MaskV m, const FloatV a, const FloatV b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+#else
+	using FloatV = float;
+	using MaskV  = bool;
+	constexpr size_t kFloatLanes = 1;
+
+	[[nodiscard]] inline FloatV Load	(const float* p)						{ return *p; }
+	[[nodiscard]] inline FloatV LoadU	(const float* p)						{ return *p; }
+	inline void					Store	(float* p, const FloatV v)				{ *p = v; }
+	inline void					StoreU	(float* p, const FloatV v)				{ *p = v; }
+	[[nodiscard]] inline FloatV Set1	(const float f)							{ return f; }
+	[[nodiscard]] inline FloatV Add		(const FloatV a, const FloatV b)		{ return a + b; }
+	[[nodiscard]] inline FloatV Sub		(const FloatV a, const FloatV b)		{ return a - b; }
+	[[nodiscard]] inline FloatV Mul		(const FloatV a, const FloatV b)		{ return a * b; }
+	[[nodiscard]] inline FloatV Div		(const FloatV a, const FloatV b)		{ return a / b; }
+	[[nodiscard]] inline FloatV Min		(const FloatV a, const FloatV b)		{ return b < a ? b : a; }
+	[[nodiscard]] inline FloatV Max		(const FloatV a, const FloatV b)		{ return a < b ? b : a; }
+	[[nodiscard]] inline FloatV Sqrt	(const FloatV a)						{ return std::sqrt(a); }
+	[[nodiscard]] inline FloatV Rsqrt	(const FloatV a)						{ return 1.0f / std::sqrt(a); }
+	[[nodiscard]] inline MaskV	CmpNeq	(const FloatV a, const FloatV b)		{ return a != b; }
+	[[nodiscard]] inline MaskV	CmpLt	(const FloatV a, const FloatV b)		{ return a < b; }
+	[[nodiscard]] inline bool	AnyOf	(const MaskV m)							{ return m; }
+	[[nodiscard]] inline FloatV Select	(const MaskV m, const FloatV a, const FloatV b) { return m ? a : b; }
+#endif
+
+	/// @brief 整数の配列演算
+	/// @brief SSE2の128bit幅で処理する (AVX環境でも256bitの整数演算にはAVX2が必要なため128bitのまま)
+	/// @brief 32bitと16bitで同じレジスタ型を使うため、関数名に要素の型を付けて区別する
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+	using Int32V = __m128i;
+	using Int16V = __m128i;
+	constexpr size_t kInt32Lanes = 4;
+	constexpr size_t kInt16Lanes = 8;
+
+	[[nodiscard]] inline Int32V LoadI32	(const int32_t* p)						{ return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+	inline void					StoreI32(int32_t* p, const Int32V v)			{ _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+	[[nodiscard]] inline Int32V Set1I32	(const int32_t i)						{ return _mm_set1_epi32(i); }
+	[[nodiscard]] inline Int32V AddI32	(const Int32V a, const Int32V b)		{ return _mm_add_epi32(a, b); }
+	[[nodiscard]] inline Int32V MinI32	(const Int32V a, const Int32V b)		{ const auto gt = _mm_cmpgt_epi32(a, b); return _mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a)); }
+	[[nodiscard]] inline Int32V MaxI32	(const Int32V a, const Int32V b)		{ const auto gt = _mm_cmpgt_epi32(a, b); return _mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b)); }
+
+	[[nodiscard]] inline Int16V LoadI16	(const int16_t* p)						{ return _mm_load_si128(reinterpret_cast<const __m128i*>(p)); }
+	inline void					StoreI16(int16_t* p, const Int16V v)			{ _mm_store_si128(reinterpret_cast<__m128i*>(p), v); }
+	[[nodiscard]] inline Int16V Set1I16	(const int16_t i)						{ return _mm_set1_epi16(i); }
+	[[nodiscard]] inline Int16V AddI16	(const Int16V a, const Int16V b)		{ return _mm_add_epi16(a, b); }
+	[[nodiscard]] inline Int16V MinI16	(const Int16V a, const Int16V b)		{ return _mm_min_epi16(a, b); }
+	[[nodiscard]] inline Int16V MaxI16	(const Int16V a, const Int16V b)		{ return _mm_max_epi16(a, b); }
+
+	/// @brief out[i] = x1[i] * x2[i] + y1[i] * y2[i] (kInt16Lanes要素分を32bitで求める)
+	inline void DotI16(const Int16V x1, const Int16V y1, const Int16V x2, const Int16V y2, int32_t* out)
+	{
+		// xとyを交互に並べて、隣り合う積の和を1命令で求める
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out),	  _mm_madd_epi16(_mm_unpacklo_epi16(x1, y1), _mm_unpacklo_epi16(x2, y2)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_madd_epi16(_mm_unpackhi_epi16(x1, y1), _mm_unpackhi_epi16(x2, y2)));
+	}
+#else
+	using Int32V = int32_t;
+	using Int16V = int16_t;
+	constexpr size_t kInt32Lanes = 1;
+	constexpr size_t kInt16Lanes = 1;
+
+	[[nodiscard]] inline Int32V LoadI32	(const int32_t* p)						{ return *p; }
+	inline void					StoreI32(int32_t* p, const Int32V v)			{ *p = v; }
+	[[nodiscard]] inline Int32V Set1I32	(const int32_t i)						{ return i; }
+	[[nodiscard]] inline Int32V AddI32	(const Int32V a, const Int32V b)		{ return static_cast<int32_t>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b)); }
+	[[nodiscard]] inline Int32V MinI32	(const Int32V a, const Int32V b)		{ return b < a ? b : a; }
+	[[nodiscard]] inline Int32V MaxI32	(const Int32V a, const Int32V b)		{ return a < b ? b : a; }
+
+	[[nodiscard]] inline Int16V LoadI16	(const int16_t* p)						{ return *p; }
+	inline void					StoreI16(int16_t* p, const Int16V v)			{ *p = v; }
+	[[nodiscard]] inline Int16V Set1I16	(const int16_t i)						{ return i; }
+	[[nodiscard]] inline Int16V AddI16	(const Int16V a, const Int16V b)		{ return static_cast<int16_t>(a + b); }
+	[[nodiscard]] inline Int16V MinI16	(const Int16V a, const Int16V b)		{ return b < a ? b : a; }
+	[[nodiscard]] inline Int16V MaxI16	(const Int16V a, const Int16V b)		{ return a < b ? b : a; }
+
+	inline void DotI16(const Int16V x1, const Int16V y1, const Int16V x2, const Int16V y2, int32_t* out)
+	{
+		*out = int32_t(x1) * x2 + int32_t(y1) * y2;
+	}
+#endif
+
+	/// @brief floatを16bit整数に変換する (0方向に切り捨て、範囲外は飽和)
+	[[nodiscard]] inline int16_t TruncToInt16(const float f)
+	{
+		if (!(f > static_cast<float>(INT16_MIN))) { return INT16_MIN; }	// NaNもSIMD側と同じくINT16_MINにする
+		if (f >= static_cast<float>(INT16_MAX)) { return INT16_MAX; }
+		return static_cast<int16_t>(f);
+	}
+
+	/// @brief 連続するkFloatLanes要素をfloatに変換して読み込む
+	/// @brief 整数配列をfloatの演算で処理する場合に使用する
+	[[nodiscard]] inline FloatV LoadAsFloat(const float* p) { return Load(p); }
+
+	[[nodiscard]] inline FloatV LoadAsFloat(const int32_t* p)
+	{
+#if defined(DXLIB_HELPER_SIMD_AVX)
+		return _mm256_cvtepi32_ps(_mm256_load_si256(reinterpret_cast<const __m256i*>(p)));
+#elif defined(DXLIB_HELPER_SIMD_SSE2)
+		return _mm_cvtepi32_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(p)));
+#else
+		return static_cast<float>(*p);
+#endif
+	}
+
+	[[nodiscard]] inline FloatV LoadAsFloat(const int16_t* p)
+	{
+#if defined(DXLIB_HELPER_SIMD_AVX)
+		// 符号拡張は上位16bitに置いてから算術シフトで行う
+		const auto v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		const auto lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+		const auto hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+#elif defined(DXLIB_HELPER_SIMD_SSE2)
+		const auto v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p));
+		return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+#else
+		return static_cast<float>(*p);
+#endif
+	}
+
+	/// @brief kFloatLanes要素を配列の型に変換して書き込む
+	/// @brief 整数への変換は0方向に切り捨てる (static_castと同じ)。16bitの場合、範囲外は飽和する
+	inline void StoreFromFloat(float* p, const FloatV v) { Store(p, v); }
+
+	inline void StoreFromFloat(int32_t* p, const FloatV v)
+	{
+#if defined(DXLIB_HELPER_SIMD_AVX)
+		_mm256_store_si256(reinterpret_cast<__m256i*>(p), _mm256_cvttps_epi32(v));
+#elif defined(DXLIB_HELPER_SIMD_SSE2)
+		_mm_store_si128(reinterpret_cast<__m128i*>(p), _mm_cvttps_epi32(v));
+#else
+		*p = static_cast<int32_t>(v);
+#endif
+	}
+
+	/// @brief 各要素を [INT16_MIN, INT16_MAX] に収める (NaNはINT16_MIN)
+	[[nodiscard]] inline FloatV ClampToInt16Range(const FloatV v)
+	{
+		return simd::Min(simd::Max(v, simd::Set1(static_cast<float>(INT16_MIN))), simd::Set1(static_cast<float>(INT16_MAX)));
+	}
+
+	inline void StoreFromFloat(int16_t* p, const FloatV v)
+	{
+		// 2^31以上はcvttpsでINT32_MINになるため、変換前にfloatでint16の範囲へ収める (NaNはINT16_MIN)
+#if defined(DXLIB_HELPER_SIMD_AVX)
+		const auto i = _mm256_cvttps_epi32(ClampToInt16Range(v));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(_mm256_castsi256_si128(i), _mm256_extractf128_si256(i, 1)));
+#elif defined(DXLIB_HELPER_SIMD_SSE2)
+		const auto i = _mm_cvttps_epi32(ClampToInt16Range(v));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(i, i));
+#else
+		*p = TruncToInt16(v);
+#endif
+	}
+
+	/// @brief 逆平方根の近似値にニュートン法を1回適用して精度を上げる
+	/// @brief Rsqrt単体の相対誤差(2^-11.4程度)を2^-21程度まで抑える
+	/// @param a 元の値
+	/// @param y aの逆平方根の近似値
+	[[nodiscard]] inline FloatV RefineRsqrt(const FloatV a, const FloatV y)
+	{
+		// y * (1.5 - 0.5 * a * y * y)
+		const auto half_a_yy = simd::Mul(simd::Mul(simd::Set1(0.5f), a), simd::Mul(y, y));
+		return simd::Mul(y, simd::Sub(simd::Set1(1.5f), half_a_yy));
+	}
+
+	/// @brief 1要素の近似逆平方根 (ニュートン法1回適用済み)
+	/// @brief SSE2が使えない環境では1.0f / std::sqrtを返す
+	[[nodiscard]] inline float RsqrtApprox(const float a)
+	{
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+		const auto av = _mm_set_ss(a);
+		const auto y  = _mm_rsqrt_ss(av);
+		const auto refined = _mm_mul_ss(y, _mm_sub_ss(_mm_set_ss(1.5f), _mm_mul_ss(_mm_mul_ss(_mm_set_ss(0.5f), av), _mm_mul_ss(y, y))));
+		return _mm_cvtss_f32(refined);
+#else
+		return 1.0f / std::sqrt(a);
+#endif
+	}
+
+	/// @brief kAlignment境界に揃えて確保するアロケータ
+	/// @brief std::vectorに渡し、Load / Storeのアライメント要件を満たす
+	template<typename T>
+	struct AlignedAllocator
+	{
+		using value_type = T;
+
+		AlignedAllocator() = default;
+
+		template<typename U>
+		AlignedAllocator(const AlignedAllocator<U>&) {}
+
+		[[nodiscard]] T* allocate(const size_t num)
+		{
+			return static_cast<T*>(::operator new(num * sizeof(T), std::align_val_t(kAlignment)));
+		}
+
+		void deallocate(T* const p, const size_t)
+		{
+			::operator delete(p, std::align_val_t(kAlignment));
+		}
+
+		template<typename U>
+		bool operator==(const AlignedAllocator<U>&) const { return true; }
+
+		template<typename U>
+		bool operator!=(const AlignedAllocator<U>&) const { return false; }
+	};
+}
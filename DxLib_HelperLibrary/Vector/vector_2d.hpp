@@ -1,6 +1,19 @@
 ﻿#pragma once
+#include <cfloat>
 #include <cmath>
+#include <type_traits>
+#include <vector>
 #include <nlohmann/json.hpp>
+#include <JSON/json_encoding.hpp>
+#include <SIMD/simd.hpp>
+
+namespace v2d::expr
+{
+	/// @brief 式テンプレートのノード (kIsExpressionを持つ型。vector_2d_expression.hpp)
+	/// @brief スカラー倍の演算子がノードを倍率として受け取らないよう、ここで定義する
+	template<typename T>
+	concept Expression = std::remove_cvref_t<T>::kIsExpression;
+}
 
 template<typename ElemT>
 struct Vector2D
@@ -8,45 +21,45 @@ struct Vector2D
     ElemT x;
     ElemT y;
 
-    Vector2D  operator+() const { return *this; }
-	Vector2D  operator-() const { return Vector2D{ -x, -y }; }
+    constexpr Vector2D  operator+() const { return *this; }
+	constexpr Vector2D  operator-() const { return Vector2D{ -x, -y }; }
 
 	template<typename T>
-    Vector2D& operator= (const Vector2D<T>& v) { x  = static_cast<ElemT>(v.x);   y  = static_cast<ElemT>(v.y);   return *this; }
+    constexpr Vector2D& operator= (const Vector2D<T>& v) { x  = static_cast<ElemT>(v.x);   y  = static_cast<ElemT>(v.y);   return *this; }
 
 	template<typename T>
-    Vector2D& operator+=(const Vector2D<T>& v) { x += static_cast<ElemT>(v.x);   y += static_cast<ElemT>(v.y);   return *this; }
+    constexpr Vector2D& operator+=(const Vector2D<T>& v) { x += static_cast<ElemT>(v.x);   y += static_cast<ElemT>(v.y);   return *this; }
 
 	template<typename T>
-    Vector2D& operator-=(const Vector2D<T>& v) { x -= static_cast<ElemT>(v.x);   y -= static_cast<ElemT>(v.y);   return *this; }
+    constexpr Vector2D& operator-=(const Vector2D<T>& v) { x -= static_cast<ElemT>(v.x);   y -= static_cast<ElemT>(v.y);   return *this; }
 
 	template<typename T>
-    Vector2D& operator*=(const Vector2D<T>& v) { x *= static_cast<ElemT>(v.x);   y *= static_cast<ElemT>(v.y);   return *this; }
+    constexpr Vector2D& operator*=(const Vector2D<T>& v) { x *= static_cast<ElemT>(v.x);   y *= static_cast<ElemT>(v.y);   return *this; }
 
 	template<typename ScaleT>
-	Vector2D& operator*=(const ScaleT scale)   { x *= static_cast<ElemT>(scale); y *= static_cast<ElemT>(scale); return *this; }
+	constexpr Vector2D& operator*=(const ScaleT scale)   { x *= static_cast<ElemT>(scale); y *= static_cast<ElemT>(scale); return *this; }
 };
 
 template<typename T, typename U>
-inline auto operator+ (const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return Vector2D<decltype(v1.x + v2.x)>{ v1.x + v2.x, v1.y + v2.y }; }
+constexpr auto operator+ (const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return Vector2D<decltype(v1.x + v2.x)>{ v1.x + v2.x, v1.y + v2.y }; }
 
 template<typename T, typename U>
-inline auto operator- (const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return Vector2D<decltype(v1.x - v2.x)>{ v1.x - v2.x, v1.y - v2.y }; }
+constexpr auto operator- (const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return Vector2D<decltype(v1.x - v2.x)>{ v1.x - v2.x, v1.y - v2.y }; }
 
 template<typename T, typename U>
-inline auto operator* (const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return Vector2D<decltype(v1.x * v2.x)>{ v1.x * v2.x, v1.y * v2.y }; }
+constexpr auto operator* (const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return Vector2D<decltype(v1.x * v2.x)>{ v1.x * v2.x, v1.y * v2.y }; }
 
-template<typename VecT, typename ScaleT>
-inline auto operator* (const Vector2D<VecT>& v, const ScaleT scale)			{ return Vector2D<VecT>{ static_cast<VecT>(v.x * scale), static_cast<VecT>(v.y * scale) }; }
+template<typename VecT, typename ScaleT> requires (!v2d::expr::Expression<ScaleT>)
+constexpr auto operator* (const Vector2D<VecT>& v, const ScaleT scale)			{ return Vector2D<VecT>{ static_cast<VecT>(v.x * scale), static_cast<VecT>(v.y * scale) }; }
 
-template<typename VecT, typename ScaleT>
-inline auto operator* (const ScaleT scale,		const Vector2D<VecT>& v)	{ return v * scale; }
+template<typename VecT, typename ScaleT> requires (!v2d::expr::Expression<ScaleT>)
+constexpr auto operator* (const ScaleT scale,		const Vector2D<VecT>& v)	{ return v * scale; }
 
 template<typename T, typename U>
-inline bool operator==(const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return v1.x == v2.x && v1.y == v2.y; }
+constexpr bool operator==(const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return v1.x == v2.x && v1.y == v2.y; }
 
 template<typename T, typename U>
-inline bool operator!=(const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return !(v1 == v2); }
+constexpr bool operator!=(const Vector2D<T>& v1,	const Vector2D<U>& v2)		{ return !(v1 == v2); }
 
 
 namespace v2d
@@ -55,20 +68,71 @@ namespace v2d
 	[[nodiscard]] inline float GetSize(const Vector2D<T>& v) { return static_cast<float>(sqrt(v.x * v.x + v.y * v.y)); }
 
 	template<typename T>
-	[[nodiscard]] inline float GetSquareSize(const Vector2D<T>& v) { return v.x * v.x + v.y * v.y; }
+	[[nodiscard]] constexpr float GetSquareSize(const Vector2D<T>& v) { return v.x * v.x + v.y * v.y; }
 
 	template<typename T>
-	[[nodiscard]] inline Vector2D<T> GetZeroV() { return { 0, 0 }; }
+	[[nodiscard]] constexpr Vector2D<T> GetZeroV() { return { 0, 0 }; }
 
+	/// @brief 正規化したベクトルを取得 (長さが0の場合はそのまま返す)
+	/// @brief 平方根1回と成分ごとの除算で求める。floatの場合、成分・長さの最大誤差は約1.5e-7 (実測)
 	template<typename T>
 	[[nodiscard]] inline Vector2D<T> GetNormalizedV(const Vector2D<T>& v)
 	{
 		float size = GetSize(v);
 		return size != 0 ? Vector2D<T>(v.x / size, v.y / size) : v;
 	}
+
+	/// @brief 正規化したベクトルを取得 (長さが0の場合はそのまま返す)
+	/// @brief 長さの逆数を1回だけ求めて乗算する。floatの場合、成分・長さの最大誤差は約1.7e-7 (実測)
+	template<typename T>
+	[[nodiscard]] inline Vector2D<T> GetNormalizedVFast(const Vector2D<T>& v)
+	{
+		const auto square_size = static_cast<float>(GetSquareSize(v));
+		if (square_size == 0.0f) { return v; }
+
+		const auto inv_size = 1.0f / std::sqrt(square_size);
+		return Vector2D<T>(v.x * inv_size, v.y * inv_size);
+	}
+
+	/// @brief 正規化したベクトルを取得 (長さが0の場合はそのまま返す)
+	/// @brief 近似逆平方根とニュートン法1回で求める。floatの場合、成分・長さの最大誤差は約3.0e-7 (長さ2^-20以上で実測)
+	/// @brief 長さの2乗がFLT_MIN未満 (長さ約1.1e-19未満) の場合は近似逆平方根が無限大になるため、GetNormalizedVFastで求める
+	template<typename T>
+	[[nodiscard]] inline Vector2D<T> GetNormalizedVApprox(const Vector2D<T>& v)
+	{
+		const auto square_size = static_cast<float>(GetSquareSize(v));
+		if (square_size < FLT_MIN) { return GetNormalizedVFast(v); }
+
+		const auto inv_size = simd::RsqrtApprox(square_size);
+		return Vector2D<T>(v.x * inv_size, v.y * inv_size);
+	}
+
+	/// @brief out[i] = GetNormalizedV(v[i]) (outはvと同じ配列でもよい)
+	template<typename T>
+	inline void Normalize(const std::vector<Vector2D<T>>& v, std::vector<Vector2D<T>>& out)
+	{
+		out.resize(v.size());
+		for (size_t i = 0; i < v.size(); ++i) { out[i] = GetNormalizedV(v[i]); }
+	}
+
+	/// @brief out[i] = GetNormalizedVFast(v[i]) (outはvと同じ配列でもよい)
+	template<typename T>
+	inline void NormalizeFast(const std::vector<Vector2D<T>>& v, std::vector<Vector2D<T>>& out)
+	{
+		out.resize(v.size());
+		for (size_t i = 0; i < v.size(); ++i) { out[i] = GetNormalizedVFast(v[i]); }
+	}
+
+	/// @brief out[i] = GetNormalizedVApprox(v[i]) (outはvと同じ配列でもよい)
+	template<typename T>
+	inline void NormalizeApprox(const std::vector<Vector2D<T>>& v, std::vector<Vector2D<T>>& out)
+	{
+		out.resize(v.size());
+		for (size_t i = 0; i < v.size(); ++i) { out[i] = GetNormalizedVApprox(v[i]); }
+	}
 	
 	template<typename T>
-	[[nodiscard]] inline float GetDot(const Vector2D<T>& v1, const Vector2D<T>& v2)
+	[[nodiscard]] constexpr float GetDot(const Vector2D<T>& v1, const Vector2D<T>& v2)
 	{
 		return v1.x * v2.x + v1.y * v2.y;
 	}
@@ -76,16 +140,31 @@ namespace v2d
 
 
 #pragma region from / to JSON
+/// @brief { "x", "y" } と [x, y] のどちらも読み込める
 template<typename T>
 inline void from_json(const nlohmann::json& j_data, Vector2D<T>& vector)
 {
+	if (j_data.is_array())
+	{
+		j_data.at(0).get_to(vector.x);
+		j_data.at(1).get_to(vector.y);
+		return;
+	}
+
 	j_data.at("x").get_to(vector.x);
 	j_data.at("y").get_to(vector.y);
 }
 
+/// @brief json_loader::IsCompactEncodingが有効な場合は [x, y] で書き出す
 template<typename T>
 inline void to_json(nlohmann::json& j_data, const Vector2D<T>& vector)
 {
+	if (json_loader::IsCompactEncoding())
+	{
+		j_data = nlohmann::json::array({ vector.x, vector.y });
+		return;
+	}
+
 	j_data = nlohmann::json
 	{
 		{ "x",	vector.x },
@@ -0,0 +1,152 @@
+﻿#pragma once
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include <Vector/vector_2d.hpp>
+
+/// @brief Vector2D配列の式テンプレート (オプトイン)
+/// @brief Refで包んだ配列同士の演算は一時配列を作らずに式を組み立て、Evaluateで式全体を要素ごとに1パスで評価する
+/// @brief 各演算の要素型・変換はvector_2d.hppの演算子と同じ規則で決まるため、要素ごとに演算子を書いた場合と同じ結果になる
+/// @brief 式中の配列同士の要素数は揃えること (異なる場合、GetSize・Evaluateはstd::length_errorを投げる)
+/// @brief 例 : v2d::expr::Evaluate(Ref(a) + Ref(b) * scale - Ref(c), out);
+namespace v2d::expr
+{
+	/// @brief 配列の参照
+	/// @brief 参照先の配列は式を評価し終えるまで有効であること
+	template<typename ElemT>
+	struct ArrayRef
+	{
+		static constexpr bool kIsExpression = true;
+		static constexpr bool kIsSized		= true;
+
+		const Vector2D<ElemT>*	data;
+		size_t					size;
+
+		[[nodiscard]] constexpr Vector2D<ElemT> operator[](const size_t index) const { return data[index]; }
+		[[nodiscard]] constexpr size_t GetSize() const { return size; }
+	};
+
+	/// @brief 全要素で同じ値 (ベクトル・スカラー)
+	/// @brief 要素数を持たないため、配列を含む式の中でのみ使用する
+	template<typename ValueT>
+	struct Constant
+	{
+		static constexpr bool kIsExpression = true;
+		static constexpr bool kIsSized		= false;
+
+		ValueT value;
+
+		[[nodiscard]] constexpr const ValueT& operator[](const size_t) const { return value; }
+		[[nodiscard]] constexpr size_t GetSize() const { return 0; }
+	};
+
+	/// @brief 二項演算
+	/// @param OpT 要素同士の演算 (std::plus<>など)
+	template<typename LhsT, typename RhsT, typename OpT>
+	struct Binary
+	{
+		static constexpr bool kIsExpression = true;
+		static constexpr bool kIsSized		= LhsT::kIsSized || RhsT::kIsSized;
+
+		LhsT lhs;
+		RhsT rhs;
+
+		[[nodiscard]] constexpr auto operator[](const size_t index) const { return OpT{}(lhs[index], rhs[index]); }
+
+		/// @brief 要素数 (片方がConstantの場合はもう片方の要素数)
+		/// @brief Constantの要素数0と空配列を区別するため、要素数の有無は型で判定する
+		[[nodiscard]] constexpr size_t GetSize() const
+		{
+			if constexpr (!LhsT::kIsSized) { return rhs.GetSize(); }
+			else if constexpr (!RhsT::kIsSized) { return lhs.GetSize(); }
+			else
+			{
+				const auto size = lhs.GetSize();
+				if (rhs.GetSize() != size) { throw std::length_error("v2d::expr : array size mismatch"); }
+				return size;
+			}
+		}
+	};
+
+	/// @brief 単項演算
+	template<typename ArgT, typename OpT>
+	struct Unary
+	{
+		static constexpr bool kIsExpression = true;
+		static constexpr bool kIsSized		= ArgT::kIsSized;
+
+		ArgT arg;
+
+		[[nodiscard]] constexpr auto operator[](const size_t index) const { return OpT{}(arg[index]); }
+		[[nodiscard]] constexpr size_t GetSize() const { return arg.GetSize(); }
+	};
+
+	/// @brief 配列を式として参照する
+	template<typename ElemT, typename AllocatorT>
+	[[nodiscard]] constexpr ArrayRef<ElemT> Ref(const std::vector<Vector2D<ElemT>, AllocatorT>& v) { return { v.data(), v.size() }; }
+
+	template<typename ElemT>
+	[[nodiscard]] constexpr ArrayRef<ElemT> Ref(const Vector2D<ElemT>* data, const size_t size) { return { data, size }; }
+
+	/// @brief 式を評価してoutに格納する (out[i] = expr[i])
+	/// @brief 各要素は同じ添字の要素のみから求めるため、outは式中の配列と同じでもよい
+	template<typename ElemT, typename AllocatorT, Expression ExprT>
+	inline void Evaluate(const ExprT& expr, std::vector<Vector2D<ElemT>, AllocatorT>& out)
+	{
+		const auto size = expr.GetSize();
+		out.resize(size);
+
+		auto* const out_data = out.data();
+		for (size_t i = 0; i < size; ++i) { out_data[i] = expr[i]; }
+	}
+
+	/// @param out 要素数分の領域を確保済みの出力先
+	template<typename ElemT, Expression ExprT>
+	inline void Evaluate(const ExprT& expr, Vector2D<ElemT>* out)
+	{
+		const auto size = expr.GetSize();
+		for (size_t i = 0; i < size; ++i) { out[i] = expr[i]; }
+	}
+
+#pragma region operators
+	template<Expression LhsT, Expression RhsT>
+	[[nodiscard]] constexpr auto operator+(const LhsT& lhs, const RhsT& rhs)			{ return Binary<LhsT, RhsT, std::plus<>>{ lhs, rhs }; }
+
+	template<Expression LhsT, typename T>
+	[[nodiscard]] constexpr auto operator+(const LhsT& lhs, const Vector2D<T>& rhs)		{ return Binary<LhsT, Constant<Vector2D<T>>, std::plus<>>{ lhs, { rhs } }; }
+
+	template<typename T, Expression RhsT>
+	[[nodiscard]] constexpr auto operator+(const Vector2D<T>& lhs, const RhsT& rhs)		{ return Binary<Constant<Vector2D<T>>, RhsT, std::plus<>>{ { lhs }, rhs }; }
+
+	template<Expression LhsT, Expression RhsT>
+	[[nodiscard]] constexpr auto operator-(const LhsT& lhs, const RhsT& rhs)			{ return Binary<LhsT, RhsT, std::minus<>>{ lhs, rhs }; }
+
+	template<Expression LhsT, typename T>
+	[[nodiscard]] constexpr auto operator-(const LhsT& lhs, const Vector2D<T>& rhs)		{ return Binary<LhsT, Constant<Vector2D<T>>, std::minus<>>{ lhs, { rhs } }; }
+
+	template<typename T, Expression RhsT>
+	[[nodiscard]] constexpr auto operator-(const Vector2D<T>& lhs, const RhsT& rhs)		{ return Binary<Constant<Vector2D<T>>, RhsT, std::minus<>>{ { lhs }, rhs }; }
+
+	/// @brief 成分ごとの積
+	template<Expression LhsT, Expression RhsT>
+	[[nodiscard]] constexpr auto operator*(const LhsT& lhs, const RhsT& rhs)			{ return Binary<LhsT, RhsT, std::multiplies<>>{ lhs, rhs }; }
+
+	template<Expression LhsT, typename T>
+	[[nodiscard]] constexpr auto operator*(const LhsT& lhs, const Vector2D<T>& rhs)		{ return Binary<LhsT, Constant<Vector2D<T>>, std::multiplies<>>{ lhs, { rhs } }; }
+
+	template<typename T, Expression RhsT>
+	[[nodiscard]] constexpr auto operator*(const Vector2D<T>& lhs, const RhsT& rhs)		{ return Binary<Constant<Vector2D<T>>, RhsT, std::multiplies<>>{ { lhs }, rhs }; }
+
+	/// @brief スカラー倍
+	template<Expression LhsT, typename ScaleT> requires std::is_arithmetic_v<ScaleT>
+	[[nodiscard]] constexpr auto operator*(const LhsT& lhs, const ScaleT scale)			{ return Binary<LhsT, Constant<ScaleT>, std::multiplies<>>{ lhs, { scale } }; }
+
+	template<typename ScaleT, Expression RhsT> requires std::is_arithmetic_v<ScaleT>
+	[[nodiscard]] constexpr auto operator*(const ScaleT scale, const RhsT& rhs)			{ return rhs * scale; }
+
+	template<Expression ArgT>
+	[[nodiscard]] constexpr auto operator-(const ArgT& arg)								{ return Unary<ArgT, std::negate<>>{ arg }; }
+#pragma endregion
+}
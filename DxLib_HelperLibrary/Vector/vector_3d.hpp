@@ -1,49 +1,112 @@
 ﻿#pragma once
+#include <cfloat>
 #include <nlohmann/json.hpp>
+#include <JSON/json_encoding.hpp>
+#include <SIMD/simd.hpp>
+#if defined(DXLIB_HELPER_HEADLESS)
+#include <Headless/dxlib_headless.hpp>
+#else
 #include <DxLib.h>
+#endif
 
-inline VECTOR operator+ (const VECTOR& v)	{ return v; }
-inline VECTOR operator- (const VECTOR& v)	{ return { -v.x, -v.y, -v.z }; }
+constexpr VECTOR operator+ (const VECTOR& v)	{ return v; }
+constexpr VECTOR operator- (const VECTOR& v)	{ return { -v.x, -v.y, -v.z }; }
 
-inline VECTOR operator+ (const VECTOR& v1, const VECTOR& v2)	{ return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z}; }
-inline VECTOR operator- (const VECTOR& v1, const VECTOR& v2)	{ return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z}; }
-inline VECTOR operator* (const VECTOR& v1, const VECTOR& v2)	{ return { v1.x * v2.x, v1.y * v2.y, v1.z * v2.z }; }
+constexpr VECTOR operator+ (const VECTOR& v1, const VECTOR& v2)	{ return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z}; }
+constexpr VECTOR operator- (const VECTOR& v1, const VECTOR& v2)	{ return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z}; }
+constexpr VECTOR operator* (const VECTOR& v1, const VECTOR& v2)	{ return { v1.x * v2.x, v1.y * v2.y, v1.z * v2.z }; }
 
 template<typename ScaleT>
-inline VECTOR operator* (const VECTOR& v, const ScaleT scale)	{ return { v.x * scale, v.y * scale, v.z * scale }; }
+constexpr VECTOR operator* (const VECTOR& v, const ScaleT scale)	{ return { v.x * scale, v.y * scale, v.z * scale }; }
 template<typename ScaleT>
-inline VECTOR operator* (const ScaleT scale, const VECTOR& v)	{ return v * scale; }
+constexpr VECTOR operator* (const ScaleT scale, const VECTOR& v)	{ return v * scale; }
 
-inline auto operator+=(VECTOR& v1, const VECTOR& v2)	{ v1.x += v2.x; v1.y += v2.y; v1.z += v2.z; return v1; }
-inline auto operator-=(VECTOR& v1, const VECTOR& v2)	{ v1.x -= v2.x; v1.y -= v2.y; v1.z -= v2.z; return v1; }
-inline auto operator*=(VECTOR& v1, const VECTOR& v2)	{ v1.x *= v2.x; v1.y *= v2.y; v1.z *= v2.z; return v1; }
+constexpr auto operator+=(VECTOR& v1, const VECTOR& v2)	{ v1.x += v2.x; v1.y += v2.y; v1.z += v2.z; return v1; }
+constexpr auto operator-=(VECTOR& v1, const VECTOR& v2)	{ v1.x -= v2.x; v1.y -= v2.y; v1.z -= v2.z; return v1; }
+constexpr auto operator*=(VECTOR& v1, const VECTOR& v2)	{ v1.x *= v2.x; v1.y *= v2.y; v1.z *= v2.z; return v1; }
 
 template<typename ScaleT>
-inline auto operator*=(VECTOR& v, const ScaleT scale)	{ v.x *= scale; v.y *= scale; v.z *= scale; return v; }
+constexpr auto operator*=(VECTOR& v, const ScaleT scale)	{ v.x *= scale; v.y *= scale; v.z *= scale; return v; }
 
-inline bool operator==(const VECTOR& v1, const VECTOR& v2){ return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z; }
-inline bool operator!=(const VECTOR& v1, const VECTOR& v2){ return !(v1 == v2); }
+constexpr bool operator==(const VECTOR& v1, const VECTOR& v2){ return v1.x == v2.x && v1.y == v2.y && v1.z == v2.z; }
+constexpr bool operator!=(const VECTOR& v1, const VECTOR& v2){ return !(v1 == v2); }
 
 
 namespace v3d
 {
-    [[nodiscard]] inline VECTOR GetZeroV()                      { return VGet(0.0f, 0.0f, 0.0f); }
-    [[nodiscard]] inline VECTOR GetNormalizedV(const VECTOR& v) { return VSize(v) != 0.0f ? VNorm(v) : v; }
+    [[nodiscard]] constexpr VECTOR GetZeroV()                   { return { 0.0f, 0.0f, 0.0f }; }
+
+    /// @brief 内積 (コンパイル時にも計算できる)
+    [[nodiscard]] constexpr float GetDot(const VECTOR& v1, const VECTOR& v2) { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+
+    /// @brief 外積 (コンパイル時にも計算できる)
+    [[nodiscard]] constexpr VECTOR GetCross(const VECTOR& v1, const VECTOR& v2)
+    {
+        return { v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x };
+    }
+
+    /// @brief 正規化したベクトルを取得 (長さが0の場合はそのまま返す)
+    /// @brief 平方根1回と成分ごとの除算で求める。成分・長さの最大誤差は約1.6e-7 (実測)
+    [[nodiscard]] inline VECTOR GetNormalizedV(const VECTOR& v)
+    {
+        const auto size = VSize(v);
+        return size != 0.0f ? VECTOR{ v.x / size, v.y / size, v.z / size } : v;
+    }
+
+    /// @brief 正規化したベクトルを取得 (長さが0の場合はそのまま返す)
+    /// @brief 長さの逆数を1回だけ求めて乗算する。成分・長さの最大誤差は約1.8e-7 (実測)
+    [[nodiscard]] inline VECTOR GetNormalizedVFast(const VECTOR& v)
+    {
+        const auto square_size = VSquareSize(v);
+        if (square_size == 0.0f) { return v; }
+
+        const auto inv_size = 1.0f / std::sqrt(square_size);
+        return { v.x * inv_size, v.y * inv_size, v.z * inv_size };
+    }
+
+    /// @brief 正規化したベクトルを取得 (長さが0の場合はそのまま返す)
+    /// @brief 近似逆平方根とニュートン法1回で求める。成分・長さの最大誤差は約3.1e-7 (長さ2^-20以上で実測)
+    /// @brief 長さの2乗が正規化数の最小値(FLT_MIN)未満、つまり長さ約1.1e-19未満の場合は近似逆平方根が無限大になるため、GetNormalizedVFastで求める
+    /// @brief 描画用の向きなど、精度より速度を優先する箇所で使用する
+    [[nodiscard]] inline VECTOR GetNormalizedVApprox(const VECTOR& v)
+    {
+        const auto square_size = VSquareSize(v);
+        if (square_size < FLT_MIN) { return GetNormalizedVFast(v); }
+
+        const auto inv_size = simd::RsqrtApprox(square_size);
+        return { v.x * inv_size, v.y * inv_size, v.z * inv_size };
+    }
 }
 
 
 #pragma region from / to JSON
 namespace DxLib
 {
+	/// @brief { "x", "y", "z" } と [x, y, z] のどちらも読み込める
 	inline void from_json(const nlohmann::json& j_data, VECTOR& vector)
 	{
+		if (j_data.is_array())
+		{
+			j_data.at(0).get_to(vector.x);
+			j_data.at(1).get_to(vector.y);
+			j_data.at(2).get_to(vector.z);
+			return;
+		}
+
 		j_data.at("x").get_to(vector.x);
 		j_data.at("y").get_to(vector.y);
 		j_data.at("z").get_to(vector.z);
 	}
 
+	/// @brief json_loader::IsCompactEncodingが有効な場合は [x, y, z] で書き出す
 	inline void to_json(nlohmann::json& j_data, const VECTOR& vector)
 	{
+		if (json_loader::IsCompactEncoding())
+		{
+			j_data = nlohmann::json::array({ vector.x, vector.y, vector.z });
+			return;
+		}
+
 		j_data = nlohmann::json
 		{
 			{ "x",	vector.x },
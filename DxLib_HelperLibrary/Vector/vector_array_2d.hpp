@@ -0,0 +1,659 @@
+﻿#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <vector>
+#include <Vector/vector_2d.hpp>
+#include <FixedPoint/fixed_point.hpp>
+#include <SIMD/simd.hpp>
+
+/// @brief floatに変換して計算する一括演算に対応する要素型
+template<typename T>
+concept Vector2DArrayFloatElement = std::same_as<T, float> || std::same_as<T, int32_t> || std::same_as<T, int16_t>;
+
+/// @brief Vector2DArrayの要素型 (Fixedは整数演算のみの一括演算に対応する)
+template<typename T>
+concept Vector2DArrayElement = Vector2DArrayFloatElement<T> || std::same_as<T, Fixed>;
+
+/// @brief Vector2Dの配列をXY成分ごとの配列(SoA)で保持するコンテナ
+/// @brief 各成分の配列はSIMD幅に揃えて確保され、v2dの一括演算でまとめて処理できる
+template<Vector2DArrayElement ElemT>
+class Vector2DArray
+{
+public:
+	Vector2DArray() = default;
+	explicit Vector2DArray(const size_t size) { Resize(size); }
+
+	[[nodiscard]] size_t GetSize() const { return x.size(); }
+	[[nodiscard]] bool   IsEmpty() const { return x.empty(); }
+
+	void Resize (const size_t size) { x.resize(size);  y.resize(size); }
+	void Reserve(const size_t size) { x.reserve(size); y.reserve(size); }
+	void Clear  ()					{ x.clear();       y.clear(); }
+
+	void PushBack(const Vector2D<ElemT>& v) { x.emplace_back(v.x); y.emplace_back(v.y); }
+
+	/// @brief 要素をVector2Dとして取得
+	[[nodiscard]] Vector2D<ElemT> Get(const size_t index) const { return { x[index], y[index] }; }
+
+	/// @brief 要素をVector2Dで設定
+	void Set(const size_t index, const Vector2D<ElemT>& v) { x[index] = v.x; y[index] = v.y; }
+
+	[[nodiscard]] ElemT*		GetX()		 { return x.data(); }
+	[[nodiscard]] ElemT*		GetY()		 { return y.data(); }
+	[[nodiscard]] const ElemT*	GetX() const { return x.data(); }
+	[[nodiscard]] const ElemT*	GetY() const { return y.data(); }
+
+private:
+	std::vector<ElemT, simd::AlignedAllocator<ElemT>> x;
+	std::vector<ElemT, simd::AlignedAllocator<ElemT>> y;
+};
+
+/// @brief Vector2DArrayの一括演算
+/// @brief 入力同士の要素数は揃えること。出力先は入力と同じ配列でもよく、要素数は入力に合わせて変更される
+/// @brief 加算・範囲制限は要素型のまま整数演算で、それ以外は要素をfloatに変換して計算する
+namespace v2d
+{
+	namespace detail
+	{
+		/// @brief kLanes要素単位で処理し、端数はスカラーで処理する
+		/// @param simd_func kLanes要素を処理する関数 (size_t index)
+		/// @param scalar_func 1要素を処理する関数 (size_t index)
+		template<size_t kLanes, typename SimdFuncT, typename ScalarFuncT>
+		inline void ForEachLane(const size_t size, SimdFuncT&& simd_func, ScalarFuncT&& scalar_func)
+		{
+			const auto simd_end = size - size % kLanes;
+
+			size_t i = 0;
+			for (; i < simd_end; i += kLanes)	{ simd_func(i); }
+			for (; i < size; ++i)				{ scalar_func(i); }
+		}
+
+		/// @brief 要素型ごとのSIMD演算
+		template<typename T>
+		struct LaneOps;
+
+		template<>
+		struct LaneOps<float>
+		{
+			using V    = simd::FloatV;
+			using DotT = float;
+			static constexpr size_t kLanes = simd::kFloatLanes;
+
+			[[nodiscard]] static V Load (const float* p)			{ return simd::Load(p); }
+			static void			   Store(float* p, const V v)		{ simd::Store(p, v); }
+			[[nodiscard]] static V Set1 (const float f)				{ return simd::Set1(f); }
+			[[nodiscard]] static V Add  (const V a, const V b)		{ return simd::Add(a, b); }
+			[[nodiscard]] static V Min  (const V a, const V b)		{ return simd::Min(a, b); }
+			[[nodiscard]] static V Max  (const V a, const V b)		{ return simd::Max(a, b); }
+
+			[[nodiscard]] static float AddScalar(const float a, const float b)		{ return a + b; }
+			[[nodiscard]] static float FromFloat(const float f)						{ return f; }
+		};
+
+		template<>
+		struct LaneOps<int32_t>
+		{
+			using V    = simd::Int32V;
+			using DotT = int64_t;
+			static constexpr size_t kLanes = simd::kInt32Lanes;
+
+			[[nodiscard]] static V Load (const int32_t* p)			{ return simd::LoadI32(p); }
+			static void			   Store(int32_t* p, const V v)		{ simd::StoreI32(p, v); }
+			[[nodiscard]] static V Set1 (const int32_t i)			{ return simd::Set1I32(i); }
+			[[nodiscard]] static V Add  (const V a, const V b)		{ return simd::AddI32(a, b); }
+			[[nodiscard]] static V Min  (const V a, const V b)		{ return simd::MinI32(a, b); }
+			[[nodiscard]] static V Max  (const V a, const V b)		{ return simd::MaxI32(a, b); }
+
+			[[nodiscard]] static int32_t AddScalar(const int32_t a, const int32_t b)	{ return static_cast<int32_t>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b)); }
+			[[nodiscard]] static int32_t FromFloat(const float f)						{ return static_cast<int32_t>(f); }
+		};
+
+		template<>
+		struct LaneOps<int16_t>
+		{
+			using V    = simd::Int16V;
+			using DotT = int32_t;
+			static constexpr size_t kLanes = simd::kInt16Lanes;
+
+			[[nodiscard]] static V Load (const int16_t* p)			{ return simd::LoadI16(p); }
+			static void			   Store(int16_t* p, const V v)		{ simd::StoreI16(p, v); }
+			[[nodiscard]] static V Set1 (const int16_t i)			{ return simd::Set1I16(i); }
+			[[nodiscard]] static V Add  (const V a, const V b)		{ return simd::AddI16(a, b); }
+			[[nodiscard]] static V Min  (const V a, const V b)		{ return simd::MinI16(a, b); }
+			[[nodiscard]] static V Max  (const V a, const V b)		{ return simd::MaxI16(a, b); }
+
+			[[nodiscard]] static int16_t AddScalar(const int16_t a, const int16_t b)	{ return static_cast<int16_t>(a + b); }
+			[[nodiscard]] static int16_t FromFloat(const float f)						{ return simd::TruncToInt16(f); }
+		};
+
+		/// @brief Fixedは内部表現(int32_t)のまま処理する
+		template<>
+		struct LaneOps<Fixed>
+		{
+			using V    = simd::Int32V;
+			using DotT = Fixed;
+			static constexpr size_t kLanes = simd::kInt32Lanes;
+
+			[[nodiscard]] static V Load (const Fixed* p)			{ return simd::LoadI32(&p->raw); }
+			static void			   Store(Fixed* p, const V v)		{ simd::StoreI32(&p->raw, v); }
+			[[nodiscard]] static V Set1 (const Fixed f)				{ return simd::Set1I32(f.raw); }
+			[[nodiscard]] static V Add  (const V a, const V b)		{ return simd::AddI32(a, b); }
+			[[nodiscard]] static V Min  (const V a, const V b)		{ return simd::MinI32(a, b); }
+			[[nodiscard]] static V Max  (const V a, const V b)		{ return simd::MaxI32(a, b); }
+
+			[[nodiscard]] static Fixed AddScalar(const Fixed a, const Fixed b)			{ return a + b; }
+		};
+	}
+
+	/// @brief 内積の出力型 (float : float, int32_t : int64_t, int16_t : int32_t, Fixed : Fixed)
+	template<Vector2DArrayElement ElemT>
+	using DotType = typename detail::LaneOps<ElemT>::DotT;
+
+	/// @brief out[i] = v1[i] + v2[i]
+	/// @brief 整数の場合、桁あふれは2の補数で折り返す
+	template<Vector2DArrayElement ElemT>
+	inline void Add(const Vector2DArray<ElemT>& v1, const Vector2DArray<ElemT>& v2, Vector2DArray<ElemT>& out)
+	{
+		using Ops = detail::LaneOps<ElemT>;
+
+		const auto size = v1.GetSize();
+		out.Resize(size);
+
+		const ElemT* x1 = v1.GetX();  const ElemT* y1 = v1.GetY();
+		const ElemT* x2 = v2.GetX();  const ElemT* y2 = v2.GetY();
+		ElemT*       xo = out.GetX(); ElemT*       yo = out.GetY();
+
+		detail::ForEachLane<Ops::kLanes>(size, [&](const size_t i)
+		{
+			Ops::Store(xo + i, Ops::Add(Ops::Load(x1 + i), Ops::Load(x2 + i)));
+			Ops::Store(yo + i, Ops::Add(Ops::Load(y1 + i), Ops::Load(y2 + i)));
+		},
+		[&](const size_t i)
+		{
+			xo[i] = Ops::AddScalar(x1[i], x2[i]);
+			yo[i] = Ops::AddScalar(y1[i], y2[i]);
+		});
+	}
+
+	/// @brief out[i] = v[i] * scale
+	/// @brief 整数の場合はfloatで乗算し、0方向に切り捨てる (Vector2D<int> * floatと同じ)。16bitの範囲外は飽和する
+	template<Vector2DArrayFloatElement ElemT>
+	inline void Scale(const Vector2DArray<ElemT>& v, const float scale, Vector2DArray<ElemT>& out)
+	{
+		using Ops = detail::LaneOps<ElemT>;
+
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const ElemT* x  = v.GetX();   const ElemT* y  = v.GetY();
+		ElemT*       xo = out.GetX(); ElemT*       yo = out.GetY();
+		const auto   s  = simd::Set1(scale);
+
+		detail::ForEachLane<simd::kFloatLanes>(size, [&](const size_t i)
+		{
+			simd::StoreFromFloat(xo + i, simd::Mul(simd::LoadAsFloat(x + i), s));
+			simd::StoreFromFloat(yo + i, simd::Mul(simd::LoadAsFloat(y + i), s));
+		},
+		[&](const size_t i)
+		{
+			xo[i] = Ops::FromFloat(static_cast<float>(x[i]) * scale);
+			yo[i] = Ops::FromFloat(static_cast<float>(y[i]) * scale);
+		});
+	}
+
+	/// @brief out[i] = v1[i]・v2[i]
+	/// @brief 整数の場合は桁あふれしないよう幅の広い型で求める (DotType)
+	/// @brief int32_tはSSE2に符号付き32bit×32bit→64bitの乗算がないため、スカラーで求める
+	/// @param out 要素数分の領域を確保済みの出力先
+	template<Vector2DArrayFloatElement ElemT>
+	inline void GetDot(const Vector2DArray<ElemT>& v1, const Vector2DArray<ElemT>& v2, DotType<ElemT>* out)
+	{
+		using DotT = DotType<ElemT>;
+
+		const ElemT* x1 = v1.GetX(); const ElemT* y1 = v1.GetY();
+		const ElemT* x2 = v2.GetX(); const ElemT* y2 = v2.GetY();
+
+		const auto scalar_func = [&](const size_t i)
+		{
+			out[i] = static_cast<DotT>(x1[i]) * x2[i] + static_cast<DotT>(y1[i]) * y2[i];
+		};
+
+		if constexpr (std::same_as<ElemT, float>)
+		{
+			detail::ForEachLane<simd::kFloatLanes>(v1.GetSize(), [&](const size_t i)
+			{
+				const auto dot = simd::Add(simd::Mul(simd::Load(x1 + i), simd::Load(x2 + i)), simd::Mul(simd::Load(y1 + i), simd::Load(y2 + i)));
+				simd::StoreU(out + i, dot);
+			}, scalar_func);
+		}
+		else if constexpr (std::same_as<ElemT, int16_t>)
+		{
+			detail::ForEachLane<simd::kInt16Lanes>(v1.GetSize(), [&](const size_t i)
+			{
+				simd::DotI16(simd::LoadI16(x1 + i), simd::LoadI16(y1 + i), simd::LoadI16(x2 + i), simd::LoadI16(y2 + i), out + i);
+			}, scalar_func);
+		}
+		else
+		{
+			for (size_t i = 0; i < v1.GetSize(); ++i) { scalar_func(i); }
+		}
+	}
+
+	/// @brief out[i] = |v[i]| (floatで求める)
+	/// @param out 要素数分の領域を確保済みの出力先
+	template<Vector2DArrayFloatElement ElemT>
+	inline void GetSize(const Vector2DArray<ElemT>& v, float* out)
+	{
+		const ElemT* x = v.GetX(); const ElemT* y = v.GetY();
+
+		detail::ForEachLane<simd::kFloatLanes>(v.GetSize(), [&](const size_t i)
+		{
+			const auto vx = simd::LoadAsFloat(x + i), vy = simd::LoadAsFloat(y + i);
+			simd::StoreU(out + i, simd::Sqrt(simd::Add(simd::Mul(vx, vx), simd::Mul(vy, vy))));
+		},
+		[&](const size_t i)
+		{
+			const auto vx = static_cast<float>(x[i]), vy = static_cast<float>(y[i]);
+			out[i] = std::sqrt(vx * vx + vy * vy);
+		});
+	}
+
+	/// @brief out[i] = v[i]を正規化したベクトル
+	/// @brief 整数の配列もfloatの配列に出力する。長さが0の要素はそのまま出力する
+	template<Vector2DArrayFloatElement ElemT>
+	inline void Normalize(const Vector2DArray<ElemT>& v, Vector2DArray<float>& out)
+	{
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const ElemT* x  = v.GetX();   const ElemT* y  = v.GetY();
+		float*       xo = out.GetX(); float*       yo = out.GetY();
+		const auto   zero = simd::Set1(0.0f);
+
+		detail::ForEachLane<simd::kFloatLanes>(size, [&](const size_t i)
+		{
+			const auto vx = simd::LoadAsFloat(x + i), vy = simd::LoadAsFloat(y + i);
+			const auto size_v   = simd::Sqrt(simd::Add(simd::Mul(vx, vx), simd::Mul(vy, vy)));
+			const auto non_zero = simd::CmpNeq(size_v, zero);
+
+			simd::Store(xo + i, simd::Select(non_zero, simd::Div(vx, size_v), vx));
+			simd::Store(yo + i, simd::Select(non_zero, simd::Div(vy, size_v), vy));
+		},
+		[&](const size_t i)
+		{
+			const auto vx = static_cast<float>(x[i]), vy = static_cast<float>(y[i]);
+			const auto size_i = std::sqrt(vx * vx + vy * vy);
+
+			xo[i] = size_i != 0.0f ? vx / size_i : vx;
+			yo[i] = size_i != 0.0f ? vy / size_i : vy;
+		});
+	}
+
+	/// @brief out[i] = v[i]を矩形 [min_pos, max_pos] の範囲に収めたベクトル
+	/// @brief min_pos <= max_pos (x, yそれぞれ) であること
+	template<Vector2DArrayElement ElemT>
+	inline void ClampToRect(const Vector2DArray<ElemT>& v, const Vector2D<ElemT>& min_pos, const Vector2D<ElemT>& max_pos, Vector2DArray<ElemT>& out)
+	{
+		using Ops = detail::LaneOps<ElemT>;
+
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const ElemT* x  = v.GetX();   const ElemT* y  = v.GetY();
+		ElemT*       xo = out.GetX(); ElemT*       yo = out.GetY();
+
+		const auto min_x = Ops::Set1(min_pos.x), min_y = Ops::Set1(min_pos.y);
+		const auto max_x = Ops::Set1(max_pos.x), max_y = Ops::Set1(max_pos.y);
+
+		detail::ForEachLane<Ops::kLanes>(size, [&](const size_t i)
+		{
+			Ops::Store(xo + i, Ops::Min(Ops::Max(Ops::Load(x + i), min_x), max_x));
+			Ops::Store(yo + i, Ops::Min(Ops::Max(Ops::Load(y + i), min_y), max_y));
+		},
+		[&](const size_t i)
+		{
+			xo[i] = std::min(std::max(x[i], min_pos.x), max_pos.x);
+			yo[i] = std::min(std::max(y[i], min_pos.y), max_pos.y);
+		});
+	}
+
+	/// @brief out[i] = |v[i] - point| (floatで求める)
+	/// @param out 要素数分の領域を確保済みの出力先
+	template<Vector2DArrayFloatElement ElemT>
+	inline void GetDistance(const Vector2DArray<ElemT>& v, const Vector2D<float>& point, float* out)
+	{
+		const ElemT* x  = v.GetX(); const ElemT* y = v.GetY();
+		const auto   px = simd::Set1(point.x);
+		const auto   py = simd::Set1(point.y);
+
+		detail::ForEachLane<simd::kFloatLanes>(v.GetSize(), [&](const size_t i)
+		{
+			const auto dx = simd::Sub(simd::LoadAsFloat(x + i), px);
+			const auto dy = simd::Sub(simd::LoadAsFloat(y + i), py);
+			simd::StoreU(out + i, simd::Sqrt(simd::Add(simd::Mul(dx, dx), simd::Mul(dy, dy))));
+		},
+		[&](const size_t i)
+		{
+			const auto dx = static_cast<float>(x[i]) - point.x;
+			const auto dy = static_cast<float>(y[i]) - point.y;
+			out[i] = std::sqrt(dx * dx + dy * dy);
+		});
+	}
+
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+	/// @brief Fixed(Q16.16)の一括演算用のSSE2演算
+	/// @brief SSE2には符号付き32bit×32bit→64bitの乗算や64bitの比較・整数の平方根がないため、以下で組み立てる
+	/// @brief   符号付きの積 : 符号なしの積(_mm_mul_epu32)の上位32bitを符号で補正する
+	/// @brief   平方根・除算 : 倍精度で求めた値に小さな値を足して切り捨て、真の値以上1以下の誤差にしてから、整数で過大な場合に1減らす
+	/// @brief いずれもスカラー版(Vector2D<Fixed>の関数)とビット単位で同じ結果になる
+	/// @brief 64bit値は_mm_mul_epu32と同じく、偶数要素(0, 2)と奇数要素(1, 3)の組に分けて扱う
+	namespace detail::fixed_lanes
+	{
+		/// @brief 倍精度の誤差(相対2^-50程度)より十分大きく、1より十分小さい補正値
+		constexpr double kRoundUp = 1.0 / 1024.0;
+
+		/// @brief 絶対値 (INT32_MINは符号なしの2^31になる)
+		[[nodiscard]] inline __m128i Abs(const __m128i v)
+		{
+			const auto sign = _mm_srai_epi32(v, 31);
+			return _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+		}
+
+		/// @brief 奇数要素を偶数要素の位置に移す (_mm_mul_epu32で奇数要素を乗算する場合に使用する)
+		[[nodiscard]] inline __m128i Odd(const __m128i v) { return _mm_srli_epi64(v, 32); }
+
+		/// @brief 偶数要素・奇数要素を倍精度に変換する (要素0, 1に置く)
+		[[nodiscard]] inline __m128d EvenToDouble(const __m128i v) { return _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(3, 1, 2, 0))); }
+		[[nodiscard]] inline __m128d OddToDouble (const __m128i v) { return _mm_cvtepi32_pd(_mm_shuffle_epi32(v, _MM_SHUFFLE(2, 0, 3, 1))); }
+
+		/// @brief 要素0, 1の符号なし32bit値を倍精度に変換する (誤差なし)
+		[[nodiscard]] inline __m128d ToDoubleU32(const __m128i v)
+		{
+			return _mm_add_pd(_mm_cvtepi32_pd(_mm_xor_si128(v, _mm_set1_epi32(INT32_MIN))), _mm_set1_pd(2147483648.0));
+		}
+
+		/// @brief 要素0, 1を要素0, 2に置く (_mm_mul_epu32の入力にする)
+		[[nodiscard]] inline __m128i Spread(const __m128i v) { return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 1, 0, 0)); }
+
+		/// @brief 2つの64bit値が負の場合に-1、それ以外は0 (要素0, 1に置く)
+		[[nodiscard]] inline __m128i NegativeMask(const __m128i pair) { return _mm_srai_epi32(_mm_shuffle_epi32(pair, _MM_SHUFFLE(3, 1, 3, 1)), 31); }
+
+		/// @brief 要素0, 1の値を偶数要素・奇数要素に戻して4要素にまとめる
+		[[nodiscard]] inline __m128i Merge(const __m128i even, const __m128i odd) { return _mm_unpacklo_epi32(even, odd); }
+
+		/// @brief 符号付きの積の和 a1 * b1 + a2 * b2 (64bit) の下位32bit・上位32bitを4要素ずつ求める
+		inline void MulAdd64(const __m128i a1, const __m128i b1, const __m128i a2, const __m128i b2, __m128i& lo, __m128i& hi)
+		{
+			// 偶数要素・奇数要素の符号なしの積の和
+			const auto even = _mm_add_epi64(_mm_mul_epu32(a1, b1), _mm_mul_epu32(a2, b2));
+			const auto odd	= _mm_add_epi64(_mm_mul_epu32(Odd(a1), Odd(b1)), _mm_mul_epu32(Odd(a2), Odd(b2)));
+
+			const auto lo_pairs = _mm_unpacklo_epi32(even, odd);
+			const auto hi_pairs = _mm_unpackhi_epi32(even, odd);
+			lo = _mm_unpacklo_epi64(lo_pairs, hi_pairs);
+			hi = _mm_unpackhi_epi64(lo_pairs, hi_pairs);
+
+			// 符号付きの積 = 符号なしの積 - (a < 0 ? b : 0) * 2^32 - (b < 0 ? a : 0) * 2^32
+			const auto correction1 = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a1, 31), b1), _mm_and_si128(_mm_srai_epi32(b1, 31), a1));
+			const auto correction2 = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a2, 31), b2), _mm_and_si128(_mm_srai_epi32(b2, 31), a2));
+			hi = _mm_sub_epi32(hi, _mm_add_epi32(correction1, correction2));
+		}
+
+		/// @brief 64bit値を16bit右シフトした値の下位32bit
+		[[nodiscard]] inline __m128i ShiftQ16(const __m128i lo, const __m128i hi) { return _mm_or_si128(_mm_slli_epi32(hi, 16), _mm_srli_epi32(lo, 16)); }
+
+		/// @brief a * b (Fixedの乗算と同じく、負の無限大方向に丸めて桁あふれは折り返す)
+		[[nodiscard]] inline __m128i Mul(const __m128i a, const __m128i b)
+		{
+			__m128i lo, hi;
+			MulAdd64(a, b, _mm_setzero_si128(), _mm_setzero_si128(), lo, hi);
+			return ShiftQ16(lo, hi);
+		}
+
+		/// @brief x1 * x2 + y1 * y2 (GetDot(Vector2D<Fixed>)と同じく、64bitの和を1回だけ丸めて飽和させる)
+		[[nodiscard]] inline __m128i Dot(const __m128i x1, const __m128i y1, const __m128i x2, const __m128i y2)
+		{
+			__m128i lo, hi;
+			MulAdd64(x1, x2, y1, y2, lo, hi);
+
+			// 16bit右シフトした値がint32_tに収まるのは、上位32bitが [-2^15, 2^15) の場合
+			const auto sign		= _mm_srai_epi32(hi, 31);
+			const auto in_range = _mm_cmpeq_epi32(_mm_srai_epi32(hi, 15), sign);
+			const auto saturate = _mm_xor_si128(sign, _mm_set1_epi32(INT32_MAX));
+			return _mm_or_si128(_mm_and_si128(in_range, ShiftQ16(lo, hi)), _mm_andnot_si128(in_range, saturate));
+		}
+
+		/// @brief 2要素の長さ (切り捨て、INT32_MAXで飽和)
+		/// @param ax, ay 絶対値 (偶数要素のみ使用)
+		/// @param dx, dy 倍精度にした成分 (要素0, 1)
+		/// @return 要素0, 1に置いた長さ
+		[[nodiscard]] inline __m128i LengthPair(const __m128i ax, const __m128i ay, const __m128d dx, const __m128d dy)
+		{
+			const auto square = _mm_add_epi64(_mm_mul_epu32(ax, ax), _mm_mul_epu32(ay, ay));
+			const auto root	  = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+
+			// 2^31以上の長さはINT32_MAXに飽和するため、変換前に収める (真の値がINT32_MAX以上なら補正後もINT32_MAX)
+			auto size = _mm_cvttpd_epi32(_mm_min_pd(_mm_add_pd(root, _mm_set1_pd(kRoundUp)), _mm_set1_pd(2147483647.0)));
+			size = _mm_add_epi32(size, NegativeMask(_mm_sub_epi64(square, _mm_mul_epu32(Spread(size), Spread(size)))));
+			return size;
+		}
+
+		/// @brief |(x, y)| (GetSize(Vector2D<Fixed>)と同じく切り捨て、範囲外は飽和)
+		[[nodiscard]] inline __m128i Length(const __m128i x, const __m128i y)
+		{
+			const auto ax = Abs(x), ay = Abs(y);
+
+			const auto even = LengthPair(ax,	  ay,	   EvenToDouble(x), EvenToDouble(y));
+			const auto odd	= LengthPair(Odd(ax), Odd(ay), OddToDouble(x),	OddToDouble(y));
+			return Merge(even, odd);
+		}
+
+		/// @brief 2要素を正規化した成分の絶対値 (GetNormalizedV(Vector2D<Fixed>)と同じ計算)
+		/// @param ax, ay 絶対値 (偶数要素のみ使用)
+		/// @param dx, dy 倍精度にした成分 (要素0, 1)
+		/// @param nx, ny 要素0, 1に置いた結果
+		inline void NormalizePair(const __m128i ax, const __m128i ay, const __m128d dx, const __m128d dy, __m128i& nx, __m128i& ny)
+		{
+			const auto square	= _mm_add_epi64(_mm_mul_epu32(ax, ax), _mm_mul_epu32(ay, ay));
+			const auto square_d = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+			const auto is_zero	= _mm_shuffle_epi32(_mm_castpd_si128(_mm_cmpeq_pd(square_d, _mm_setzero_pd())), _MM_SHUFFLE(2, 2, 2, 0));
+			const auto root		= _mm_sqrt_pd(square_d);
+
+			// 商の近似値 |d| * 2^16 / |(x, y)| は、整数の長さで割った真の商との差が2^-14程度のため、
+			// シフト量や整数の長さを待たずに求め、最後に整数で1だけ補正する
+			const auto scale_d = _mm_div_pd(_mm_set1_pd(65536.0), root);
+
+			// スカラー版と同じく、square << shift が2^63未満に収まる最大の偶数だけ左シフトする (shift = 2 * k)
+			// squareのビット数は、上位・下位32bitを倍精度にした値の大きい方の指数部から誤差なく求める
+			const auto hi_d		= _mm_mul_pd(ToDoubleU32(_mm_shuffle_epi32(square, _MM_SHUFFLE(3, 3, 3, 1))), _mm_set1_pd(4294967296.0));
+			const auto lo_d		= ToDoubleU32(_mm_shuffle_epi32(square, _MM_SHUFFLE(2, 2, 2, 0)));
+			const auto exponent = _mm_srli_epi64(_mm_castpd_si128(_mm_max_pd(hi_d, lo_d)), 52);	// ビット数 + 1022
+
+			// k = max(0, 63 - ビット数) / 2 (長さ0の場合は31に収め、結果は最後に0にする)
+			auto k = _mm_sub_epi32(_mm_set1_epi32(1085), exponent);
+			k = _mm_srli_epi32(_mm_and_si128(k, _mm_cmpgt_epi32(k, _mm_setzero_si128())), 1);
+			k = _mm_and_si128(k, _mm_set1_epi64x(0xffffffff));
+			const auto k_over = _mm_cmpgt_epi32(k, _mm_set1_epi32(31));
+			k = _mm_or_si128(_mm_andnot_si128(k_over, k), _mm_and_si128(k_over, _mm_set1_epi64x(31)));
+
+			// 2^k (k = 31は変換が範囲外になり0x80000000を返すが、これは符号なしの2^31と等しい)
+			const auto pow_d = _mm_castsi128_pd(_mm_slli_epi64(_mm_add_epi64(k, _mm_set1_epi64x(1023)), 52));
+			const auto pow_i = Spread(_mm_cvttpd_epi32(pow_d));
+
+			// (ax, ay) * 2^k は2^32未満に収まるため、シフト後の長さの2乗も誤差なく求められる
+			const auto sx = _mm_mul_epu32(ax, pow_i), sy = _mm_mul_epu32(ay, pow_i);
+			const auto shifted_square = _mm_add_epi64(_mm_mul_epu32(sx, sx), _mm_mul_epu32(sy, sy));
+
+			// シフト後の長さは [2^30.5, 2^31.5] のため、2^30を引いて符号付き32bitに変換する
+			auto size = _mm_cvttpd_epi32(_mm_add_pd(_mm_mul_pd(root, pow_d), _mm_set1_pd(kRoundUp - 1073741824.0)));
+			size = _mm_add_epi32(size, _mm_set1_epi32(1 << 30));
+			size = _mm_add_epi32(size, NegativeMask(_mm_sub_epi64(shifted_square, _mm_mul_epu32(Spread(size), Spread(size)))));
+
+			const auto size_i	= Spread(size);
+			const auto abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(INT64_MAX));
+
+			// (s * 2^16) / size の切り捨て
+			const auto divide = [&](const __m128i scaled, const __m128d d)
+			{
+				auto quotient = _mm_cvttpd_epi32(_mm_add_pd(_mm_mul_pd(_mm_and_pd(d, abs_mask), scale_d), _mm_set1_pd(kRoundUp)));
+				quotient = _mm_add_epi32(quotient, NegativeMask(_mm_sub_epi64(_mm_slli_epi64(scaled, 16), _mm_mul_epu32(Spread(quotient), size_i))));
+				return _mm_andnot_si128(is_zero, quotient);
+			};
+
+			nx = divide(sx, dx);
+			ny = divide(sy, dy);
+		}
+
+		/// @brief (x, y)を正規化したベクトル (GetNormalizedV(Vector2D<Fixed>)と同じ結果)
+		inline void Normalize(const __m128i x, const __m128i y, __m128i& nx, __m128i& ny)
+		{
+			const auto ax = Abs(x), ay = Abs(y);
+
+			__m128i nx_even, ny_even, nx_odd, ny_odd;
+			NormalizePair(ax,	   ay,		EvenToDouble(x), EvenToDouble(y), nx_even, ny_even);
+			NormalizePair(Odd(ax), Odd(ay), OddToDouble(x),	 OddToDouble(y),  nx_odd,  ny_odd);
+
+			// 0方向への切り捨てのため、絶対値の商に元の符号を付ける
+			const auto sign_x = _mm_srai_epi32(x, 31), sign_y = _mm_srai_epi32(y, 31);
+			nx = _mm_sub_epi32(_mm_xor_si128(Merge(nx_even, nx_odd), sign_x), sign_x);
+			ny = _mm_sub_epi32(_mm_xor_si128(Merge(ny_even, ny_odd), sign_y), sign_y);
+		}
+	}
+#endif
+
+	/// @brief out[i] = v[i] * scale (Fixed)
+	inline void Scale(const Vector2DArray<Fixed>& v, const Fixed scale, Vector2DArray<Fixed>& out)
+	{
+		using Ops = detail::LaneOps<Fixed>;
+
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const Fixed* x  = v.GetX();   const Fixed* y  = v.GetY();
+		Fixed*       xo = out.GetX(); Fixed*       yo = out.GetY();
+
+		const auto scalar_func = [&](const size_t i)
+		{
+			xo[i] = x[i] * scale;
+			yo[i] = y[i] * scale;
+		};
+
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+		const auto s = Ops::Set1(scale);
+		detail::ForEachLane<Ops::kLanes>(size, [&](const size_t i)
+		{
+			Ops::Store(xo + i, detail::fixed_lanes::Mul(Ops::Load(x + i), s));
+			Ops::Store(yo + i, detail::fixed_lanes::Mul(Ops::Load(y + i), s));
+		}, scalar_func);
+#else
+		for (size_t i = 0; i < size; ++i) { scalar_func(i); }
+#endif
+	}
+
+	/// @brief out[i] = v1[i]・v2[i] (Fixed)
+	/// @brief 各要素はGetDot(Vector2D<Fixed>)と同じく、64bitの積の和を1回だけ丸める
+	/// @param out 要素数分の領域を確保済みの出力先
+	inline void GetDot(const Vector2DArray<Fixed>& v1, const Vector2DArray<Fixed>& v2, Fixed* out)
+	{
+		using Ops = detail::LaneOps<Fixed>;
+
+		const Fixed* x1 = v1.GetX(); const Fixed* y1 = v1.GetY();
+		const Fixed* x2 = v2.GetX(); const Fixed* y2 = v2.GetY();
+
+		const auto scalar_func = [&](const size_t i)
+		{
+			out[i] = GetDot(Vector2D<Fixed>{ x1[i], y1[i] }, Vector2D<Fixed>{ x2[i], y2[i] });
+		};
+
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+		detail::ForEachLane<Ops::kLanes>(v1.GetSize(), [&](const size_t i)
+		{
+			const auto dot = detail::fixed_lanes::Dot(Ops::Load(x1 + i), Ops::Load(y1 + i), Ops::Load(x2 + i), Ops::Load(y2 + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i].raw), dot);
+		}, scalar_func);
+#else
+		for (size_t i = 0; i < v1.GetSize(); ++i) { scalar_func(i); }
+#endif
+	}
+
+	/// @brief out[i] = |v[i]| (Fixed。GetSize(Vector2D<Fixed>)と同じ結果)
+	/// @param out 要素数分の領域を確保済みの出力先
+	inline void GetSize(const Vector2DArray<Fixed>& v, Fixed* out)
+	{
+		using Ops = detail::LaneOps<Fixed>;
+
+		const Fixed* x = v.GetX(); const Fixed* y = v.GetY();
+
+		const auto scalar_func = [&](const size_t i)
+		{
+			out[i] = GetSize(Vector2D<Fixed>{ x[i], y[i] });
+		};
+
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+		detail::ForEachLane<Ops::kLanes>(v.GetSize(), [&](const size_t i)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i].raw), detail::fixed_lanes::Length(Ops::Load(x + i), Ops::Load(y + i)));
+		}, scalar_func);
+#else
+		for (size_t i = 0; i < v.GetSize(); ++i) { scalar_func(i); }
+#endif
+	}
+
+	/// @brief out[i] = v[i]を正規化したベクトル (Fixed。GetNormalizedV(Vector2D<Fixed>)と同じ結果)
+	inline void Normalize(const Vector2DArray<Fixed>& v, Vector2DArray<Fixed>& out)
+	{
+		using Ops = detail::LaneOps<Fixed>;
+
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const Fixed* x  = v.GetX();   const Fixed* y  = v.GetY();
+		Fixed*       xo = out.GetX(); Fixed*       yo = out.GetY();
+
+		const auto scalar_func = [&](const size_t i)
+		{
+			const auto normalized = GetNormalizedV(Vector2D<Fixed>{ x[i], y[i] });
+			xo[i] = normalized.x;
+			yo[i] = normalized.y;
+		};
+
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+		detail::ForEachLane<Ops::kLanes>(size, [&](const size_t i)
+		{
+			__m128i nx, ny;
+			detail::fixed_lanes::Normalize(Ops::Load(x + i), Ops::Load(y + i), nx, ny);
+			Ops::Store(xo + i, nx);
+			Ops::Store(yo + i, ny);
+		}, scalar_func);
+#else
+		for (size_t i = 0; i < size; ++i) { scalar_func(i); }
+#endif
+	}
+
+	/// @brief out[i] = |v[i] - point| (Fixed)
+	/// @param out 要素数分の領域を確保済みの出力先
+	inline void GetDistance(const Vector2DArray<Fixed>& v, const Vector2D<Fixed>& point, Fixed* out)
+	{
+		using Ops = detail::LaneOps<Fixed>;
+
+		const Fixed* x = v.GetX(); const Fixed* y = v.GetY();
+
+		const auto scalar_func = [&](const size_t i)
+		{
+			out[i] = GetSize(Vector2D<Fixed>{ x[i] - point.x, y[i] - point.y });
+		};
+
+#if defined(DXLIB_HELPER_SIMD_SSE2)
+		const auto px = Ops::Set1(point.x), py = Ops::Set1(point.y);
+		detail::ForEachLane<Ops::kLanes>(v.GetSize(), [&](const size_t i)
+		{
+			const auto dx = _mm_sub_epi32(Ops::Load(x + i), px);
+			const auto dy = _mm_sub_epi32(Ops::Load(y + i), py);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i].raw), detail::fixed_lanes::Length(dx, dy));
+		}, scalar_func);
+#else
+		for (size_t i = 0; i < v.GetSize(); ++i) { scalar_func(i); }
+#endif
+	}
+}
@@ -0,0 +1,323 @@
+﻿#pragma once
+#include <cfloat>
+#include <vector>
+#include <Vector/vector_3d.hpp>
+#include <SIMD/simd.hpp>
+
+/// @brief VECTORの配列をXYZ成分ごとの配列(SoA)で保持するコンテナ
+/// @brief 各成分の配列はSIMD幅に揃えて確保され、v3dの一括演算でまとめて処理できる
+class VectorArray3
+{
+public:
+	VectorArray3() = default;
+	explicit VectorArray3(const size_t size) { Resize(size); }
+
+	[[nodiscard]] size_t GetSize() const { return x.size(); }
+	[[nodiscard]] bool   IsEmpty() const { return x.empty(); }
+
+	void Resize (const size_t size) { x.resize(size);  y.resize(size);  z.resize(size); }
+	void Reserve(const size_t size) { x.reserve(size); y.reserve(size); z.reserve(size); }
+	void Clear  ()					{ x.clear();       y.clear();       z.clear(); }
+
+	void PushBack(const VECTOR& v)	{ x.emplace_back(v.x); y.emplace_back(v.y); z.emplace_back(v.z); }
+
+	/// @brief 要素をVECTORとして取得
+	[[nodiscard]] VECTOR Get(const size_t index) const { return { x[index], y[index], z[index] }; }
+
+	/// @brief 要素をVECTORで設定
+	void Set(const size_t index, const VECTOR& v) { x[index] = v.x; y[index] = v.y; z[index] = v.z; }
+
+	[[nodiscard]] float*		GetX()		 { return x.data(); }
+	[[nodiscard]] float*		GetY()		 { return y.data(); }
+	[[nodiscard]] float*		GetZ()		 { return z.data(); }
+	[[nodiscard]] const float*	GetX() const { return x.data(); }
+	[[nodiscard]] const float*	GetY() const { return y.data(); }
+	[[nodiscard]] const float*	GetZ() const { return z.data(); }
+
+private:
+	std::vector<float, simd::AlignedAllocator<float>> x;
+	std::vector<float, simd::AlignedAllocator<float>> y;
+	std::vector<float, simd::AlignedAllocator<float>> z;
+};
+
+/// @brief VectorArray3の一括演算
+/// @brief 入力同士の要素数は揃えること。出力先は入力と同じ配列でもよく、要素数は入力に合わせて変更される
+namespace v3d
+{
+	namespace detail
+	{
+		/// @brief SIMD幅単位で処理し、端数はスカラーで処理する
+		/// @param simd_func SIMD幅分の要素を処理する関数 (size_t index)
+		/// @param scalar_func 1要素を処理する関数 (size_t index)
+		template<typename SimdFuncT, typename ScalarFuncT>
+		inline void ForEachLane(const size_t size, SimdFuncT&& simd_func, ScalarFuncT&& scalar_func)
+		{
+			const auto simd_end = size - size % simd::kFloatLanes;
+
+			size_t i = 0;
+			for (; i < simd_end; i += simd::kFloatLanes)	{ simd_func(i); }
+			for (; i < size; ++i)							{ scalar_func(i); }
+		}
+	}
+
+	/// @brief out[i] = v1[i] + v2[i]
+	inline void Add(const VectorArray3& v1, const VectorArray3& v2, VectorArray3& out)
+	{
+		const auto size = v1.GetSize();
+		out.Resize(size);
+
+		const float* x1 = v1.GetX(); const float* y1 = v1.GetY(); const float* z1 = v1.GetZ();
+		const float* x2 = v2.GetX(); const float* y2 = v2.GetY(); const float* z2 = v2.GetZ();
+		float*       xo = out.GetX(); float*      yo = out.GetY(); float*      zo = out.GetZ();
+
+		detail::ForEachLane(size, [&](const size_t i)
+		{
+			simd::Store(xo + i, simd::Add(simd::Load(x1 + i), simd::Load(x2 + i)));
+			simd::Store(yo + i, simd::Add(simd::Load(y1 + i), simd::Load(y2 + i)));
+			simd::Store(zo + i, simd::Add(simd::Load(z1 + i), simd::Load(z2 + i)));
+		},
+		[&](const size_t i)
+		{
+			out.Set(i, v1.Get(i) + v2.Get(i));
+		});
+	}
+
+	/// @brief out[i] = v1[i] - v2[i]
+	inline void Sub(const VectorArray3& v1, const VectorArray3& v2, VectorArray3& out)
+	{
+		const auto size = v1.GetSize();
+		out.Resize(size);
+
+		const float* x1 = v1.GetX(); const float* y1 = v1.GetY(); const float* z1 = v1.GetZ();
+		const float* x2 = v2.GetX(); const float* y2 = v2.GetY(); const float* z2 = v2.GetZ();
+		float*       xo = out.GetX(); float*      yo = out.GetY(); float*      zo = out.GetZ();
+
+		detail::ForEachLane(size, [&](const size_t i)
+		{
+			simd::Store(xo + i, simd::Sub(simd::Load(x1 + i), simd::Load(x2 + i)));
+			simd::Store(yo + i, simd::Sub(simd::Load(y1 + i), simd::Load(y2 + i)));
+			simd::Store(zo + i, simd::Sub(simd::Load(z1 + i), simd::Load(z2 + i)));
+		},
+		[&](const size_t i)
+		{
+			out.Set(i, v1.Get(i) - v2.Get(i));
+		});
+	}
+
+	/// @brief out[i] = v[i] * scale
+	inline void Scale(const VectorArray3& v, const float scale, VectorArray3& out)
+	{
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const float* x  = v.GetX();   const float* y  = v.GetY();   const float* z  = v.GetZ();
+		float*       xo = out.GetX(); float*       yo = out.GetY(); float*       zo = out.GetZ();
+		const auto   s  = simd::Set1(scale);
+
+		detail::ForEachLane(size, [&](const size_t i)
+		{
+			simd::Store(xo + i, simd::Mul(simd::Load(x + i), s));
+			simd::Store(yo + i, simd::Mul(simd::Load(y + i), s));
+			simd::Store(zo + i, simd::Mul(simd::Load(z + i), s));
+		},
+		[&](const size_t i)
+		{
+			out.Set(i, v.Get(i) * scale);
+		});
+	}
+
+	/// @brief out[i] = v1[i]・v2[i]
+	/// @param out 要素数分の領域を確保済みの出力先
+	inline void GetDot(const VectorArray3& v1, const VectorArray3& v2, float* out)
+	{
+		const float* x1 = v1.GetX(); const float* y1 = v1.GetY(); const float* z1 = v1.GetZ();
+		const float* x2 = v2.GetX(); const float* y2 = v2.GetY(); const float* z2 = v2.GetZ();
+
+		detail::ForEachLane(v1.GetSize(), [&](const size_t i)
+		{
+			auto dot = simd::Mul(simd::Load(x1 + i), simd::Load(x2 + i));
+			dot = simd::Add(dot, simd::Mul(simd::Load(y1 + i), simd::Load(y2 + i)));
+			dot = simd::Add(dot, simd::Mul(simd::Load(z1 + i), simd::Load(z2 + i)));
+			simd::StoreU(out + i, dot);
+		},
+		[&](const size_t i)
+		{
+			out[i] = x1[i] * x2[i] + y1[i] * y2[i] + z1[i] * z2[i];
+		});
+	}
+
+	/// @brief out[i] = v1[i]×v2[i]
+	inline void GetCross(const VectorArray3& v1, const VectorArray3& v2, VectorArray3& out)
+	{
+		const auto size = v1.GetSize();
+		out.Resize(size);
+
+		const float* x1 = v1.GetX(); const float* y1 = v1.GetY(); const float* z1 = v1.GetZ();
+		const float* x2 = v2.GetX(); const float* y2 = v2.GetY(); const float* z2 = v2.GetZ();
+		float*       xo = out.GetX(); float*      yo = out.GetY(); float*      zo = out.GetZ();
+
+		detail::ForEachLane(size, [&](const size_t i)
+		{
+			const auto ax = simd::Load(x1 + i), ay = simd::Load(y1 + i), az = simd::Load(z1 + i);
+			const auto bx = simd::Load(x2 + i), by = simd::Load(y2 + i), bz = simd::Load(z2 + i);
+
+			simd::Store(xo + i, simd::Sub(simd::Mul(ay, bz), simd::Mul(az, by)));
+			simd::Store(yo + i, simd::Sub(simd::Mul(az, bx), simd::Mul(ax, bz)));
+			simd::Store(zo + i, simd::Sub(simd::Mul(ax, by), simd::Mul(ay, bx)));
+		},
+		[&](const size_t i)
+		{
+			const auto a = v1.Get(i);
+			const auto b = v2.Get(i);
+			out.Set(i, { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x });
+		});
+	}
+
+	/// @brief out[i] = |v[i]|
+	/// @param out 要素数分の領域を確保済みの出力先
+	inline void GetSize(const VectorArray3& v, float* out)
+	{
+		const float* x = v.GetX(); const float* y = v.GetY(); const float* z = v.GetZ();
+
+		detail::ForEachLane(v.GetSize(), [&](const size_t i)
+		{
+			const auto vx = simd::Load(x + i), vy = simd::Load(y + i), vz = simd::Load(z + i);
+			simd::StoreU(out + i, simd::Sqrt(simd::Add(simd::Add(simd::Mul(vx, vx), simd::Mul(vy, vy)), simd::Mul(vz, vz))));
+		},
+		[&](const size_t i)
+		{
+			out[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+		});
+	}
+
+	/// @brief out[i] = v[i]を正規化したベクトル
+	/// @brief GetNormalizedVと同じく、長さが0の要素はそのまま出力する
+	inline void Normalize(const VectorArray3& v, VectorArray3& out)
+	{
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const float* x  = v.GetX();   const float* y  = v.GetY();   const float* z  = v.GetZ();
+		float*       xo = out.GetX(); float*       yo = out.GetY(); float*       zo = out.GetZ();
+		const auto   zero = simd::Set1(0.0f);
+
+		detail::ForEachLane(size, [&](const size_t i)
+		{
+			const auto vx = simd::Load(x + i), vy = simd::Load(y + i), vz = simd::Load(z + i);
+			const auto size_v   = simd::Sqrt(simd::Add(simd::Add(simd::Mul(vx, vx), simd::Mul(vy, vy)), simd::Mul(vz, vz)));
+			const auto non_zero = simd::CmpNeq(size_v, zero);
+
+			simd::Store(xo + i, simd::Select(non_zero, simd::Div(vx, size_v), vx));
+			simd::Store(yo + i, simd::Select(non_zero, simd::Div(vy, size_v), vy));
+			simd::Store(zo + i, simd::Select(non_zero, simd::Div(vz, size_v), vz));
+		},
+		[&](const size_t i)
+		{
+			const auto vi     = v.Get(i);
+			const auto size_i = std::sqrt(vi.x * vi.x + vi.y * vi.y + vi.z * vi.z);
+			out.Set(i, size_i != 0.0f ? VECTOR{ vi.x / size_i, vi.y / size_i, vi.z / size_i } : vi);
+		});
+	}
+
+	/// @brief out[i] = v[i]を正規化したベクトル (GetNormalizedVFastと同じ精度)
+	/// @brief 長さの逆数を1回だけ求めて乗算する。長さが0の要素はそのまま出力する
+	inline void NormalizeFast(const VectorArray3& v, VectorArray3& out)
+	{
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const float* x  = v.GetX();   const float* y  = v.GetY();   const float* z  = v.GetZ();
+		float*       xo = out.GetX(); float*       yo = out.GetY(); float*       zo = out.GetZ();
+		const auto   zero = simd::Set1(0.0f);
+		const auto   one  = simd::Set1(1.0f);
+
+		detail::ForEachLane(size, [&](const size_t i)
+		{
+			const auto vx = simd::Load(x + i), vy = simd::Load(y + i), vz = simd::Load(z + i);
+			const auto square_size = simd::Add(simd::Add(simd::Mul(vx, vx), simd::Mul(vy, vy)), simd::Mul(vz, vz));
+			const auto non_zero    = simd::CmpNeq(square_size, zero);
+			const auto inv_size    = simd::Select(non_zero, simd::Div(one, simd::Sqrt(square_size)), one);
+
+			simd::Store(xo + i, simd::Mul(vx, inv_size));
+			simd::Store(yo + i, simd::Mul(vy, inv_size));
+			simd::Store(zo + i, simd::Mul(vz, inv_size));
+		},
+		[&](const size_t i)
+		{
+			out.Set(i, GetNormalizedVFast(v.Get(i)));
+		});
+	}
+
+	/// @brief out[i] = v[i]を正規化したベクトル (GetNormalizedVApproxと同じ精度)
+	/// @brief 近似逆平方根とニュートン法1回で求める。長さの2乗がFLT_MIN未満の要素を含むレーンは、GetNormalizedVApproxと同じくGetNormalizedVFastで求める
+	inline void NormalizeApprox(const VectorArray3& v, VectorArray3& out)
+	{
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const float* x  = v.GetX();   const float* y  = v.GetY();   const float* z  = v.GetZ();
+		float*       xo = out.GetX(); float*       yo = out.GetY(); float*       zo = out.GetZ();
+		const auto   min_square_size = simd::Set1(FLT_MIN);
+
+		detail::ForEachLane(size, [&](const size_t i)
+		{
+			const auto vx = simd::Load(x + i), vy = simd::Load(y + i), vz = simd::Load(z + i);
+			const auto square_size = simd::Add(simd::Add(simd::Mul(vx, vx), simd::Mul(vy, vy)), simd::Mul(vz, vz));
+
+			// 非正規化数・0の長さは近似逆平方根が無限大になるため、まれなケースとしてスカラーで処理する
+			if (simd::AnyOf(simd::CmpLt(square_size, min_square_size)))
+			{
+				for (size_t j = 0; j < simd::kFloatLanes; ++j) { out.Set(i + j, GetNormalizedVApprox(v.Get(i + j))); }
+				return;
+			}
+
+			const auto inv_size = simd::RefineRsqrt(square_size, simd::Rsqrt(square_size));
+
+			simd::Store(xo + i, simd::Mul(vx, inv_size));
+			simd::Store(yo + i, simd::Mul(vy, inv_size));
+			simd::Store(zo + i, simd::Mul(vz, inv_size));
+		},
+		[&](const size_t i)
+		{
+			out.Set(i, GetNormalizedVApprox(v.Get(i)));
+		});
+	}
+
+	/// @brief out[i] = VTransform(v[i], mat)
+	/// @brief 座標として変換するため、行列の座標成分も加算される
+	inline void Transform(const VectorArray3& v, const MATRIX& mat, VectorArray3& out)
+	{
+		const auto size = v.GetSize();
+		out.Resize(size);
+
+		const float* x  = v.GetX();   const float* y  = v.GetY();   const float* z  = v.GetZ();
+		float*       xo = out.GetX(); float*       yo = out.GetY(); float*       zo = out.GetZ();
+
+		const auto& m = mat.m;
+		const simd::FloatV m0[3] = { simd::Set1(m[0][0]), simd::Set1(m[0][1]), simd::Set1(m[0][2]) };
+		const simd::FloatV m1[3] = { simd::Set1(m[1][0]), simd::Set1(m[1][1]), simd::Set1(m[1][2]) };
+		const simd::FloatV m2[3] = { simd::Set1(m[2][0]), simd::Set1(m[2][1]), simd::Set1(m[2][2]) };
+		const simd::FloatV m3[3] = { simd::Set1(m[3][0]), simd::Set1(m[3][1]), simd::Set1(m[3][2]) };
+
+		detail::ForEachLane(size, [&](const size_t i)
+		{
+			const auto vx = simd::Load(x + i), vy = simd::Load(y + i), vz = simd::Load(z + i);
+			float* const outs[3] = { xo + i, yo + i, zo + i };
+
+			// 端数のスカラー処理と同じく左から順に加算し、配列内の位置やSIMDの有無で結果が変わらないようにする
+			for (int j = 0; j < 3; ++j)
+			{
+				simd::Store(outs[j], simd::Add(simd::Add(simd::Add(simd::Mul(vx, m0[j]), simd::Mul(vy, m1[j])), simd::Mul(vz, m2[j])), m3[j]));
+			}
+		},
+		[&](const size_t i)
+		{
+			const auto vi = v.Get(i);
+			out.Set(i, {
+				vi.x * m[0][0] + vi.y * m[1][0] + vi.z * m[2][0] + m[3][0],
+				vi.x * m[0][1] + vi.y * m[1][1] + vi.z * m[2][1] + m[3][1],
+				vi.x * m[0][2] + vi.y * m[1][2] + vi.z * m[2][2] + m[3][2]
+			});
+		});
+	}
+}